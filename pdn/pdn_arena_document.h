@@ -0,0 +1,80 @@
+#ifndef PDN_Header_pdn_arena_document
+#define PDN_Header_pdn_arena_document
+
+#include <cstddef>
+#include <new>
+#include <memory_resource>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+
+#include "pdn_unicode_base.h"
+#include "pdn_type_config.h"
+#include "pdn_memory_resource.h"
+#include "pdn_entity.h"
+
+namespace pdn
+{
+	// document made in monotonic buffer, the buffer is freed at once when document is destroyed,
+	// entities of document are not destroyed one by one.
+	// requires entities configured with PDN_Macro_entity_memory_resource (see pdn_type_config.h).
+	// notes:
+	//     entities put into document later should be made in scope() of it, memory they hold out of the buffer is leaked;
+	//     proxy made by default or moved from allocates at first non-const access, access it in scope() too;
+	//     entities of document must not be used after it is destroyed;
+	//     lazy_document made in scope() should be expanded in scope() too.
+	template <unicode::concepts::code_unit char_t>
+	class arena_document
+	{
+		static_assert(type::config::entity_memory_resource, "[pdn] arena_document requires PDN_Macro_entity_memory_resource");
+	public:
+		using char_type   = char_t;
+		using entity_type = entity<char_type>;
+		using size_type   = ::std::size_t;
+		static constexpr size_type default_initial_size = 64 * 1024;
+	public:
+		auto root() noexcept -> entity_type&
+		{
+			return *root_entity;
+		}
+		auto root() const noexcept -> const entity_type&
+		{
+			return *root_entity;
+		}
+		// entities made in returned scope are made in buffer of document
+		auto scope() noexcept -> memory_resource_scope
+		{
+			return memory_resource_scope{ &buffer };
+		}
+		auto resource() noexcept -> ::std::pmr::memory_resource*
+		{
+			return &buffer;
+		}
+
+		// make is called in scope(), and it returns root entity of document, such as by pdn::parse
+		template <::std::invocable make_t>
+			requires ::std::convertible_to<::std::invoke_result_t<make_t>, entity_type>
+		explicit arena_document(make_t&& make, size_type initial_size = default_initial_size) :
+			buffer{ initial_size }
+		{
+			auto s = scope();
+			auto p = buffer.allocate(sizeof(entity_type), alignof(entity_type));
+			root_entity = ::new (p) entity_type(::std::invoke(::std::forward<make_t>(make)));
+		}
+		arena_document(const arena_document&) = delete;
+		arena_document& operator=(const arena_document&) = delete;
+		// root entity is not destroyed, memory of all entities is released by buffer
+		~arena_document() = default;
+	private:
+		::std::pmr::monotonic_buffer_resource buffer;
+		entity_type*                          root_entity{};
+	};
+
+	template <unicode::concepts::code_unit char_t, ::std::invocable make_t>
+	[[nodiscard]] auto make_arena_document(make_t&& make, char_t = {}) -> arena_document<char_t>
+	{
+		return arena_document<char_t>{ ::std::forward<make_t>(make) };
+	}
+}
+
+#endif
@@ -0,0 +1,332 @@
+#ifndef PDN_Header_pdn_async_swap_chain
+#define PDN_Header_pdn_async_swap_chain
+
+#include <type_traits>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//    byte input stream (provide: get byte) // such as ifstream
+//     |
+//     +---> BOM reader (provide: get BOM)
+//     |         extra: requires byte input stream has operation seekg
+//     v
+// >> swap chain (provide: get byte)
+//        async swap chain fills ring of buffers by worker thread
+//     |
+//     v
+//    code unit iterator (provide: get code unit, move backward(++it), check EOF)
+//     |
+//     +---- utf-8 decoder ---+
+//     |                      |
+//     +---- utf-16 decoder --+---- (provide: decode to get unicode code-point)
+//     |                      |
+//     +---- utf-32 decoder --+
+//     v
+//    code point iterator (provide: get code point, move backward(++it), check EOF)
+//     |
+//     v
+//    lexer (provide: get token{ token code, value, token position })
+//     |
+//     v
+//    parser (provide: parse) ----> pdn document object model
+
+namespace pdn::concepts
+{
+	// reader(buffer, size) fills buffer with at most size objects and returns count of them,
+	// returns 0 when no more data.
+	// it is called by worker thread of async_swap_chain only.
+	template <typename type, typename char_t>
+	concept async_chain_reader = requires(type reader, char_t* buffer, ::std::size_t size)
+	{
+		{ reader(buffer, size) } -> ::std::convertible_to<::std::size_t>;
+	};
+}
+
+namespace pdn
+{
+	template <typename istream_t = ::std::istream>
+	class istream_chain_reader
+	{
+	public:
+		using istream_type = istream_t;
+		using char_type    = typename istream_type::char_type;
+		using size_type    = ::std::size_t;
+		size_type operator()(char_type* buffer, size_type size)
+		{
+			if (!*istream_ptr)
+			{
+				return 0;
+			}
+			istream_ptr->read(buffer, static_cast<::std::streamsize>(size));
+			return static_cast<size_type>(istream_ptr->gcount());
+		}
+		explicit istream_chain_reader(istream_type& istream) : istream_ptr{ &istream }
+		{
+			// istream cannot have bad state
+			if (istream_ptr->bad())
+			{
+				throw ::std::invalid_argument("input_stream badbit can not be true!");
+			}
+			// clear failbit when it in fail state
+			istream_ptr->clear(istream_ptr->rdstate() & ::std::ios::eofbit);
+		}
+	private:
+		istream_type* istream_ptr{};
+	};
+
+	// swap chain with ring of buffer_count buffers,
+	// buffers are filled by worker thread ahead of the consumer, so reading overlaps lexing.
+	// worker thread is joined when async_swap_chain is destroyed.
+	template <typename char_t = char, concepts::async_chain_reader<char_t> reader_t = istream_chain_reader<>>
+	class async_swap_chain
+	{
+	public:
+		using reader_type = reader_t;
+		using size_type   = ::std::size_t;
+		using char_type   = char_t;
+		using value_type  = char_type;
+	private:
+		class async_swap_chain_iterator
+		{
+		private:
+			using swap_chain_type = async_swap_chain;
+		public:
+			using iterator_concept  = void;
+			using iterator_category = void;
+			using size_type         = typename swap_chain_type::size_type;
+			using value_type        = typename swap_chain_type::value_type;
+			swap_chain_type& origin()
+			{
+				return *swap_ptr;
+			}
+			const swap_chain_type& origin() const
+			{
+				return *swap_ptr;
+			}
+			bool eof() const
+			{
+				return *this == async_swap_chain_iterator{};
+			}
+			const value_type& operator*() const // cannot dereference end
+			{
+				return origin().get();
+			}
+			async_swap_chain_iterator& operator++ () // cannot ++end
+			{
+				origin().to_next();
+				if (origin().eof())
+				{
+					swap_ptr = nullptr; // swap_ptr == nullptr -> end
+				}
+				return *this;
+			}
+			friend bool operator==(async_swap_chain_iterator, async_swap_chain_iterator) = default;
+			async_swap_chain_iterator() = default; // default constructor make itself be end iterator
+			explicit async_swap_chain_iterator(async_swap_chain& swap) : swap_ptr{ swap.eof() ? nullptr : &swap } {}
+		private:
+			swap_chain_type* swap_ptr{ nullptr }; // swap_ptr == nullptr means it is end
+		};
+		friend class async_swap_chain_iterator;
+	public:
+		using const_iterator = async_swap_chain_iterator;
+		using iterator = const_iterator;
+	public:
+		const_iterator current() noexcept
+		{
+			return const_iterator{ *this };
+		}
+		const_iterator end() noexcept
+		{
+			return const_iterator{};
+		}
+		const value_type& get() const
+		{
+			return *current_pos;
+		}
+		bool eof() const noexcept
+		{
+			return current_pos == current_end;
+		}
+		void to_next()
+		{
+			if (current_pos != current_end) // if eof was reached, acquiring next buffer is awful!
+			{
+				++current_pos;
+				if (current_pos == current_end)
+				{
+					release_current_buffer();
+					acquire_next_buffer();
+				}
+			}
+		}
+		size_type size() const noexcept
+		{
+			return buffer_size;
+		}
+		size_type count() const noexcept
+		{
+			return buffer_count;
+		}
+		size_type id() const noexcept
+		{
+			return consumed;
+		}
+	private:
+		value_type* get_buffer_ptr(size_type sequence) noexcept
+		{
+			return buffers_mng.get() + (sequence % buffer_count) * buffer_size;
+		}
+		// consumer: wait for buffer filled by worker, empty buffer means eof
+		void acquire_next_buffer()
+		{
+			::std::unique_lock lock{ mtx };
+			cv.wait(lock, [this]() { return produced != consumed; });
+			if (reader_exception)
+			{
+				auto e = ::std::exchange(reader_exception, nullptr);
+				lock.unlock();
+				current_pos = current_end = nullptr;
+				::std::rethrow_exception(e);
+			}
+			auto* buffer = get_buffer_ptr(consumed);
+			current_pos  = buffer;
+			current_end  = buffer + filled_sizes[consumed % buffer_count];
+		}
+		// consumer: give buffer back to worker
+		void release_current_buffer()
+		{
+			{
+				::std::lock_guard lock{ mtx };
+				++consumed;
+			}
+			cv.notify_all();
+		}
+		void stop_worker() noexcept
+		{
+			{
+				::std::lock_guard lock{ mtx };
+				stopping = true;
+			}
+			cv.notify_all();
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+		// worker: fill free buffers until reader returns 0 or chain is destroyed
+		void work()
+		{
+			for (size_type sequence{}; ; ++sequence)
+			{
+				{
+					::std::unique_lock lock{ mtx };
+					cv.wait(lock, [this]() { return stopping || produced - consumed < buffer_count; });
+					if (stopping)
+					{
+						return;
+					}
+				}
+				size_type filled{};
+				::std::exception_ptr e{};
+				try
+				{
+					filled = static_cast<size_type>(reader(get_buffer_ptr(sequence), buffer_size));
+					if (filled > buffer_size)
+					{
+						throw ::std::length_error("reader of async_swap_chain returns count greater than buffer size");
+					}
+				}
+				catch (...)
+				{
+					filled = 0;
+					e = ::std::current_exception();
+				}
+				{
+					::std::lock_guard lock{ mtx };
+					filled_sizes[sequence % buffer_count] = filled;
+					reader_exception = e;
+					++produced;
+				}
+				cv.notify_all();
+				if (filled == 0) // eof or error, consumer reads empty buffer as eof
+				{
+					return;
+				}
+			}
+		}
+	public:
+		async_swap_chain(reader_type buffer_reader,
+		                 size_type   buf_size  = 64 * 1024,
+		                 size_type   buf_count = 4) :
+			buffer_size { buf_size },
+			buffer_count{ buf_count },
+			reader      { ::std::move(buffer_reader) }
+		{
+			if (buffer_size <= 0)
+			{
+				throw ::std::invalid_argument("argument buffer size can not less than or equal to 0");
+			}
+			if (buffer_count < 2)
+			{
+				throw ::std::invalid_argument("argument buffer count can not less than 2");
+			}
+			if (buffer_size > ::std::numeric_limits<size_type>::max() / buffer_count)
+			{
+				throw ::std::invalid_argument("argument buffer size * buffer count can not greater than numeric_limits<size_type>::max()");
+			}
+			buffers_mng  = ::std::make_unique<value_type[]>(buffer_size * buffer_count);
+			filled_sizes.resize(buffer_count);
+			worker       = ::std::thread{ [this]() { work(); } };
+			try
+			{
+				acquire_next_buffer();
+			}
+			catch (...)
+			{
+				stop_worker();
+				throw;
+			}
+		}
+		async_swap_chain(const async_swap_chain&) = delete;
+		async_swap_chain& operator=(const async_swap_chain&) = delete;
+		~async_swap_chain()
+		{
+			stop_worker();
+		}
+	private:
+		const value_type*               current_pos{};      // current position
+		const value_type*               current_end{};      // end of filled part of current buffer
+		size_type                       buffer_size{};      // size of each buffer
+		size_type                       buffer_count{};     // count of buffers in ring
+		reader_type                     reader;             // used by worker thread only
+		::std::unique_ptr<value_type[]> buffers_mng;        // buffer_count adjacent buffers
+		::std::vector<size_type>        filled_sizes;       // filled size of each buffer, guarded by mtx
+		size_type                       produced{};         // count of filled buffers, guarded by mtx
+		size_type                       consumed{};         // count of released buffers, guarded by mtx
+		bool                            stopping{};         // guarded by mtx
+		::std::exception_ptr            reader_exception{}; // guarded by mtx
+		::std::mutex                    mtx;
+		::std::condition_variable       cv;
+		::std::thread                   worker;
+	};
+
+	template <typename istream_t = ::std::istream>
+	inline auto make_async_swap_chain(istream_t& istream, ::std::size_t buf_size = 64 * 1024, ::std::size_t buf_count = 4)
+	{
+		using char_type = typename istream_t::char_type;
+		return async_swap_chain<char_type, istream_chain_reader<istream_t>>{ istream_chain_reader<istream_t>{ istream }, buf_size, buf_count };
+	}
+}
+
+#endif
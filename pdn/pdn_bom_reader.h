@@ -9,6 +9,7 @@
 #include <array>
 #include <span>
 #include <type_traits>
+#include <iterator>
 
 #include "pdn_unicode_base.h"
 
@@ -125,6 +126,39 @@ namespace pdn::unicode
 
 		return result;
 	}
+
+	// read bom from contiguous byte range (such as memory mapped file)
+	// moves begin past the BOM, begin is unchanged when no BOM was found.
+	template <::std::contiguous_iterator it_t>
+		requires (sizeof(::std::iter_value_t<it_t>) == 1)
+	auto read_bom(it_t& begin, it_t end) -> bom_type
+	{
+		using byte_type = bom::byte_t;
+		using enum bom_type;
+
+		auto starts_with = [&](const auto& bom_seq)
+		{
+			if (static_cast<::std::size_t>(end - begin) < bom_seq.size())
+			{
+				return false;
+			}
+			return ::std::equal(bom_seq.cbegin(), bom_seq.cend(), begin,
+				[](byte_type lhs, auto rhs) { return lhs == static_cast<byte_type>(rhs); });
+		};
+		auto consume = [&](const auto& bom_seq, bom_type result)
+		{
+			begin += bom_seq.size();
+			return result;
+		};
+
+		// utf-32 le must be tested before utf-16 le, FF FE is prefix of FF FE 00 00
+		if (starts_with(bom::utf32_le)) return consume(bom::utf32_le, utf32_le);
+		if (starts_with(bom::utf32_be)) return consume(bom::utf32_be, utf32_be);
+		if (starts_with(bom::utf8))     return consume(bom::utf8,     utf8);
+		if (starts_with(bom::utf16_le)) return consume(bom::utf16_le, utf16_le);
+		if (starts_with(bom::utf16_be)) return consume(bom::utf16_be, utf16_be);
+		return no_bom;
+	}
 }
 
 #endif
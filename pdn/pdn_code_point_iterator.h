@@ -9,8 +9,11 @@
 #include <memory>
 #include <format>
 #include <cstdint>
+#include <array>
+#include <span>
 
 #include "pdn_unicode.h"
+#include "pdn_code_unit_iterator.h"
 #include "pdn_convert_decision.h"
 #include "pdn_raw_error_message.h"
 #include "pdn_error_message.h"
@@ -74,6 +77,19 @@ namespace pdn::detail
 	using decode_result_to_raw_error_t = decode_result_to_raw_error<type>::type;
 }
 
+namespace pdn::detail
+{
+	// code point iterator which decodes code points into staging array ahead,
+	// staged_code_points() are code points from current one to the end of stage,
+	// skip_code_points(n) moves n code points forward, position of each code point is still recorded.
+	template <typename it_t>
+	concept staged_code_point_iterator = requires(it_t it, const it_t cit, ::std::size_t count)
+	{
+		{ cit.staged_code_points() } -> ::std::convertible_to<::std::span<const unicode::code_point_t>>;
+		it.skip_code_points(count);
+	};
+}
+
 namespace pdn
 {
 	template <typename begin_it_t, typename end_it_t, concepts::function_package_for_code_point_iterator function_package>
@@ -172,6 +188,351 @@ namespace pdn
 		unicode::code_point_t curr_value{};
 	};
 
+	// for contiguous code units (such as string_view or memory mapped file),
+	// decodes runs of code points into staging array and reads code units by raw pointer.
+	// decoding stops before malformed sequence, so errors are still reported when the sequence is reached.
+	template <::std::contiguous_iterator                         begin_it_t,
+	          ::std::sized_sentinel_for<begin_it_t>              end_it_t,
+	          concepts::function_package_for_code_point_iterator function_package>
+	class code_point_iterator<begin_it_t, end_it_t, function_package>
+	{
+	public:
+		using iterator_concept  = void;
+		using iterator_category = void;
+		using code_unit_type    = ::std::iter_value_t<begin_it_t>;
+		using char_type         = unicode::code_point_t;
+		using size_type         = ::std::size_t;
+		using value_type        = char_type;
+	private:
+		using unit_pointer      = const code_unit_type*;
+		using decision          = unicode::convert_decision<::std::basic_string_view<code_unit_type>, unicode::ucpstring>;
+		static constexpr size_type stage_capacity{ 64 };
+		static constexpr bool      has_ascii_decoder = requires(unit_pointer it, char_type* out)
+		{
+			decision::decoder_type::decode_ascii(it, it, out, size_type{});
+		};
+	public:
+		const char_type& get() const noexcept
+		{
+			return stage[stage_pos];
+		}
+		bool eof() const noexcept
+		{
+			return stage_pos == stage_size;
+		}
+		void to_next()
+		{
+			func_pkg->update(get());
+			if (!eof() && ++stage_pos == stage_size)
+			{
+				refill();
+			}
+		}
+		// decoded code points from current one, empty when eof was reached
+		::std::span<const char_type> staged_code_points() const noexcept
+		{
+			return { stage.data() + stage_pos, stage_size - stage_pos };
+		}
+		// count can not be greater than staged_code_points().size()
+		void skip_code_points(size_type count)
+		{
+			for (size_type i{}; i < count; ++i)
+			{
+				func_pkg->update(stage[stage_pos + i]);
+			}
+			stage_pos += count;
+			if (count != 0 && stage_pos == stage_size)
+			{
+				refill();
+			}
+		}
+		const char_type& operator*() const noexcept
+		{
+			return get();
+		}
+		code_point_iterator& operator++()
+		{
+			to_next();
+			return *this;
+		}
+		template <typename it_other_t>
+		friend bool operator==(const code_point_iterator& lhs, const it_other_t& rhs) noexcept
+		{
+			return lhs.eof() && (rhs - lhs.origin) == (lhs.next - lhs.first);
+		}
+	private:
+		void refill()
+		{
+			// keep value of last code point when eof was reached, same as generic code_point_iterator
+			const auto last_value = stage_size != 0 ? stage[stage_size - 1] : stage[stage_pos];
+			stage_pos  = 0;
+			stage_size = 0;
+			auto it = next;
+			while (stage_size < stage_capacity && it != last)
+			{
+				if constexpr (has_ascii_decoder)
+				{
+					stage_size += decision::decoder_type::decode_ascii(it, last, stage.data() + stage_size, stage_capacity - stage_size);
+					if (stage_size == stage_capacity || it == last)
+					{
+						break;
+					}
+				}
+				// code unit in range [0, 0x80) is code point itself in utf-8, utf-16 and utf-32
+				else if (::std::make_unsigned_t<code_unit_type>(*it) < 0x80u) [[likely]]
+				{
+					stage[stage_size++] = char_type(*it);
+					++it;
+					continue;
+				}
+				auto seq_it = it;
+				auto result = decision::template decode<false>(seq_it, last);
+				if (!result) [[unlikely]]
+				{
+					break; // report error when reaching it
+				}
+				stage[stage_size++] = result.value();
+				it = seq_it + 1;
+			}
+			next = it;
+			if (stage_size == 0 && next != last) [[unlikely]]
+			{
+				decode_with_error();
+			}
+			if (stage_size == 0)
+			{
+				stage[0] = last_value;
+			}
+		}
+		// decode one code point, report and skip malformed sequences before it
+		void decode_with_error()
+		{
+			while (next != last)
+			{
+				auto it = next;
+				auto result = decision::template decode<false>(it, last);
+				if (result)
+				{
+					stage[stage_size++] = result.value();
+					next = it + 1;
+					return;
+				}
+				using result_type = decltype(result);
+				const auto last_unit = it == last ? code_unit_type{} : *it;
+				const auto offset    = base + static_cast<size_type>(it - first);
+				func_pkg->handle_error(error_message{
+					result.errc(),
+					func_pkg->position(),
+					func_pkg->generate_error_message(raw_error_message{
+						result.errc(),
+						func_pkg->position(),
+						detail::decode_result_to_raw_error_t<result_type>{ result, last_unit, offset }
+					})
+				});
+				if (it != last && !decision::decoder_type::template is_reaching_next<false>(result))
+				{
+					++it;
+				}
+				next = it;
+			}
+		}
+	public:
+		code_point_iterator(begin_it_t begin_it, end_it_t end_it, function_package& func_package) :
+			func_pkg{ &func_package },
+			origin  { begin_it },
+			first   { ::std::to_address(begin_it) },
+			last    { first + (end_it - begin_it) },
+			next    { first }
+		{
+			refill();
+		}
+		// for part of source, offset is offset of begin_it in source, offsets in decode errors count from start of source
+		code_point_iterator(begin_it_t begin_it, end_it_t end_it, function_package& func_package, size_type offset) :
+			func_pkg{ &func_package },
+			origin  { begin_it },
+			first   { ::std::to_address(begin_it) },
+			last    { first + (end_it - begin_it) },
+			next    { first },
+			base    { offset }
+		{
+			refill();
+		}
+	private:
+		function_package*                         func_pkg{};
+		begin_it_t                                origin;       // for comparing with end iterator
+		unit_pointer                              first{};      // first code unit
+		unit_pointer                              last{};       // past the last code unit
+		unit_pointer                              next{};       // first code unit not decoded yet
+		size_type                                 base{};       // offset of first code unit in source
+		size_type                                 stage_pos{};  // current code point in stage
+		size_type                                 stage_size{}; // count of decoded code points in stage
+		::std::array<char_type, stage_capacity>   stage{};      // decoded code points
+	};
+
+	// for code unit iterator staging blocks of native code units (such as utf-16/utf-32 from memory mapped file),
+	// decodes staged code units in bulk, sequences crossing blocks or malformed sequences are decoded one by one.
+	template <detail::staged_code_unit_iterator                 begin_it_t,
+	          typename                                           end_it_t,
+	          concepts::function_package_for_code_point_iterator function_package>
+	class code_point_iterator<begin_it_t, end_it_t, function_package>
+	{
+	public:
+		using iterator_concept  = void;
+		using iterator_category = void;
+		using code_unit_type    = typename begin_it_t::code_unit_type;
+		using char_type         = unicode::code_point_t;
+		using size_type         = ::std::size_t;
+		using value_type        = char_type;
+	private:
+		using unit_pointer      = const code_unit_type*;
+		using decision          = unicode::convert_decision<::std::basic_string_view<code_unit_type>, unicode::ucpstring>;
+		static constexpr size_type stage_capacity{ 64 };
+	public:
+		const char_type& get() const noexcept
+		{
+			return stage[stage_pos];
+		}
+		bool eof() const noexcept
+		{
+			return stage_pos == stage_size;
+		}
+		void to_next()
+		{
+			func_pkg->update(get());
+			if (!eof() && ++stage_pos == stage_size)
+			{
+				refill();
+			}
+		}
+		// decoded code points from current one, empty when eof was reached
+		::std::span<const char_type> staged_code_points() const noexcept
+		{
+			return { stage.data() + stage_pos, stage_size - stage_pos };
+		}
+		// count can not be greater than staged_code_points().size()
+		void skip_code_points(size_type count)
+		{
+			for (size_type i{}; i < count; ++i)
+			{
+				func_pkg->update(stage[stage_pos + i]);
+			}
+			stage_pos += count;
+			if (count != 0 && stage_pos == stage_size)
+			{
+				refill();
+			}
+		}
+		const char_type& operator*() const noexcept
+		{
+			return get();
+		}
+		code_point_iterator& operator++()
+		{
+			to_next();
+			return *this;
+		}
+		template <typename it_other_t>
+		friend bool operator==(const code_point_iterator& lhs, const it_other_t& rhs) noexcept
+		{
+			return lhs.eof() && lhs.begin == rhs;
+		}
+	private:
+		void refill()
+		{
+			// keep value of last code point when eof was reached, same as generic code_point_iterator
+			const auto last_value = stage_size != 0 ? stage[stage_size - 1] : stage[stage_pos];
+			stage_pos  = 0;
+			stage_size = 0;
+			while (stage_size < stage_capacity && begin != end)
+			{
+				const auto units = begin.staged_units();
+				unit_pointer       it   = units.data();
+				const unit_pointer last = it + units.size();
+				while (stage_size < stage_capacity && it != last)
+				{
+					// code unit in range [0, 0x80) is code point itself in utf-16 and utf-32
+					if (::std::make_unsigned_t<code_unit_type>(*it) < 0x80u) [[likely]]
+					{
+						stage[stage_size++] = char_type(*it);
+						++it;
+						continue;
+					}
+					auto seq_it = it;
+					auto result = decision::template decode<false>(seq_it, last);
+					if (!result) [[unlikely]]
+					{
+						break; // malformed or crosses block, decode it by code unit iterator later
+					}
+					stage[stage_size++] = result.value();
+					it = seq_it + 1;
+				}
+				const auto count = static_cast<size_type>(it - units.data());
+				begin.skip_units(count);
+				offset += count;
+				if (it != last)
+				{
+					break;
+				}
+			}
+			if (stage_size == 0 && begin != end) [[unlikely]]
+			{
+				decode_with_error();
+			}
+			if (stage_size == 0)
+			{
+				stage[0] = last_value;
+			}
+		}
+		// decode one code point by code unit iterator, report and skip malformed sequences before it
+		void decode_with_error()
+		{
+			while (begin != end)
+			{
+				auto result = decision::template decode<false>(begin, end);
+				offset += result.distance();
+				if (result)
+				{
+					stage[stage_size++] = result.value();
+					++begin;
+					++offset;
+					return;
+				}
+				using result_type = decltype(result);
+				const auto last_unit = begin == end ? code_unit_type{} : *begin;
+				func_pkg->handle_error(error_message{
+					result.errc(),
+					func_pkg->position(),
+					func_pkg->generate_error_message(raw_error_message{
+						result.errc(),
+						func_pkg->position(),
+						detail::decode_result_to_raw_error_t<result_type>{ result, last_unit, offset }
+					})
+				});
+				if (begin != end && !decision::decoder_type::template is_reaching_next<false>(result))
+				{
+					++begin;
+					++offset;
+				}
+			}
+		}
+	public:
+		code_point_iterator(begin_it_t begin_it, end_it_t end_it, function_package& func_package) :
+			func_pkg{ &func_package },
+			begin   { ::std::move(begin_it) },
+			end     { ::std::move(end_it) }
+		{
+			refill();
+		}
+	private:
+		function_package*                         func_pkg{};
+		size_type                                 offset{};     // offset of begin in code units
+		begin_it_t                                begin;        // first code unit not decoded yet
+		end_it_t                                  end;
+		size_type                                 stage_pos{};  // current code point in stage
+		size_type                                 stage_size{}; // count of decoded code points in stage
+		::std::array<char_type, stage_capacity>   stage{};      // decoded code points
+	};
+
 	template <typename begin_it_t, typename end_it_t, concepts::function_package_for_code_point_iterator function_package>
 	inline auto make_code_point_iterator(begin_it_t begin_it, end_it_t end_it, function_package& func_package)
 	{
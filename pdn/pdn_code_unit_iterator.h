@@ -8,8 +8,13 @@
 #include <limits>
 #include <memory>
 #include <iterator>
+#include <cstring>
+#include <cstdint>
+#include <span>
+#include <array>
 
 #include "pdn_unicode_base.h"
+#include "pdn_unicode_simd.h"
 #include "pdn_eof_checker_concept.h"
 
 // requires 1 Byte = 8 bits
@@ -95,7 +100,7 @@ namespace pdn::detail
 				{
 					break;
 				}
-				curr_value |= (char_type(::std::make_unsigned_t<typename it_t::value_type>(*begin)) << offset);
+				curr_value |= (char_type(::std::make_unsigned_t<::std::iter_value_t<it_t>>(*begin)) << offset);
 			}
 			return curr_value;
 		}
@@ -112,7 +117,7 @@ namespace pdn::detail
 				{
 					break;
 				}
-				curr_value |= (char_type(::std::make_unsigned_t<typename it_t::value_type>(*begin)) << offset);
+				curr_value |= (char_type(::std::make_unsigned_t<::std::iter_value_t<it_t>>(*begin)) << offset);
 			}
 			return curr_value;
 		}
@@ -122,7 +127,7 @@ namespace pdn::detail
 			auto curr_value = char_type{};
 			for (size_type offset{}; !is_eof(); )
 			{
-				curr_value |= (char_type(::std::make_unsigned_t<typename it_t::value_type>(*begin)) << offset);
+				curr_value |= (char_type(::std::make_unsigned_t<::std::iter_value_t<it_t>>(*begin)) << offset);
 				offset += bits_count_of_byte;
 				if (offset < bits_count_of_unit)
 				{
@@ -140,7 +145,7 @@ namespace pdn::detail
 			for (size_type offset{ bits_count_of_unit }; !is_eof(); )
 			{
 				offset -= bits_count_of_byte;
-				curr_value |= (char_type(::std::make_unsigned_t<typename it_t::value_type>(*begin)) << offset);
+				curr_value |= (char_type(::std::make_unsigned_t<::std::iter_value_t<it_t>>(*begin)) << offset);
 				if (offset > 0)
 				{
 					++begin;
@@ -153,6 +158,21 @@ namespace pdn::detail
 	};
 }
 
+namespace pdn::detail
+{
+	template <typename it_t>
+	concept contiguous_byte_iterator = ::std::contiguous_iterator<it_t> && sizeof(::std::iter_value_t<it_t>) == 1;
+
+	// code unit iterator which stages a block of native code units,
+	// staged_units() are code units from current one to the end of block, skip_units(n) moves n code units forward.
+	template <typename it_t>
+	concept staged_code_unit_iterator = requires(it_t it, const it_t cit, ::std::size_t count)
+	{
+		{ cit.staged_units() } -> ::std::convertible_to<::std::span<const typename it_t::code_unit_type>>;
+		it.skip_units(count);
+	};
+}
+
 namespace pdn
 {
 	template <unicode::encode_type encode_type, typename it_t>
@@ -260,6 +280,121 @@ namespace pdn
 		char_type curr_value{};
 	};
 
+	// for contiguous bytes (such as memory mapped file), converts a block of bytes to native code units at once,
+	// bytes of opposite byte order are swapped by simd shuffle. code point iterator decodes staged units in bulk.
+	template <unicode::encode_type encode_type, detail::contiguous_byte_iterator it_t>
+		requires (encode_type != unicode::encode_type::utf8)
+	class code_unit_iterator<encode_type, it_t>
+	{
+	public:
+		using iterator_concept  = void;
+		using iterator_category = void;
+		using code_unit_type    = unicode::type_traits::code_unit_t<encode_type>;
+		using char_type         = code_unit_type;
+		using size_type         = ::std::size_t;
+		using value_type        = char_type;
+	private:
+		using byte_pointer      = const unsigned char*;
+		using helper            = detail::code_unit_iterator_helper<encode_type, byte_pointer>;
+		static constexpr size_type unit_size{ sizeof(char_type) };
+		static constexpr size_type block_capacity{ 128 };
+		void load_block()
+		{
+			// incomplete code unit at the end of bytes is dropped, same as byte by byte reading
+			const auto rest = static_cast<size_type>(end - block) / unit_size;
+			stage_pos  = 0;
+			stage_size = rest < block_capacity ? rest : block_capacity;
+			if (stage_size == 0) [[unlikely]]
+			{
+				block = end;
+				return;
+			}
+			auto bytes = reinterpret_cast<byte_pointer>(::std::to_address(block));
+			if constexpr (source_endian() == ::std::endian::native)
+			{
+				::std::memcpy(stage.data(), bytes, stage_size * unit_size);
+			}
+			else if constexpr (::std::endian::native == ::std::endian::little || ::std::endian::native == ::std::endian::big)
+			{
+				unicode::simd::byteswap_units(bytes, stage_size, stage.data());
+			}
+			else // mixed endian platform
+			{
+				for (size_type i{}; i < stage_size; ++i)
+				{
+					auto unit_end = bytes + unit_size;
+					stage[i] = helper::first_to_next(bytes, [&]() { return bytes == unit_end; });
+					bytes = unit_end;
+				}
+			}
+		}
+		void next_block()
+		{
+			block += static_cast<::std::iter_difference_t<it_t>>(stage_size * unit_size);
+			load_block();
+		}
+		it_t position() const
+		{
+			return block + static_cast<::std::iter_difference_t<it_t>>(stage_pos * unit_size);
+		}
+	public:
+		static constexpr ::std::endian source_endian() noexcept
+		{
+			return helper::source_endian();
+		}
+		const char_type& get() const noexcept
+		{
+			return stage[stage_pos];
+		}
+		void to_next()
+		{
+			if (stage_pos != stage_size && ++stage_pos == stage_size)
+			{
+				next_block();
+			}
+		}
+		// native code units from current one to the end of staged block, empty when eof was reached
+		::std::span<const char_type> staged_units() const noexcept
+		{
+			return { stage.data() + stage_pos, stage_size - stage_pos };
+		}
+		// count can not be greater than staged_units().size()
+		void skip_units(size_type count)
+		{
+			stage_pos += count;
+			if (stage_pos == stage_size)
+			{
+				next_block();
+			}
+		}
+		const char_type& operator*() const noexcept
+		{
+			return get();
+		}
+		code_unit_iterator& operator++ ()
+		{
+			to_next();
+			return *this;
+		}
+		template <typename it_other_t>
+		friend bool operator== (const code_unit_iterator& lhs, const it_other_t& rhs) noexcept
+		{
+			return lhs.position() == rhs;
+		}
+		code_unit_iterator(it_t bytestream_begin, it_t bytestream_end) :
+			block{ ::std::move(bytestream_begin) },
+			end  { ::std::move(bytestream_end) }
+		{
+			load_block();
+		}
+	private:
+		it_t                                     block;        // first byte of staged block, end when eof was reached
+		it_t                                     end;
+		size_type                                stage_pos{};  // current code unit in stage
+		size_type                                stage_size{}; // count of code units in stage
+		::std::array<char_type, block_capacity>  stage{};      // native code units of block
+	};
+
 	namespace detail::for_code_unit_iterator_u8
 	{
 		template <typename it_t>
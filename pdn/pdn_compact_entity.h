@@ -0,0 +1,786 @@
+#ifndef PDN_Header_pdn_compact_entity
+#define PDN_Header_pdn_compact_entity
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "pdn_type.h"
+#include "pdn_type_code.h"
+#include "pdn_proxy.h"
+#include "pdn_utf_code_convert.h"
+#include "pdn_entity_utility.h"
+#include "pdn_entity.h"
+
+namespace pdn
+{
+	template <typename char_t>
+	class compact_entity;
+}
+
+namespace pdn::type
+{
+	template <typename char_t>
+	using compact_list = config::list<compact_entity<char_t>>;
+
+	template <typename char_t>
+	using compact_object = config::object<object_key<char_t>, compact_entity<char_t>>;
+}
+
+namespace pdn
+{
+	// entity of 16 bytes for documents kept in memory in large numbers, holds same types as entity.
+	// value of 8 bytes is followed by type code and size of character in padding bytes of the value,
+	// so character is held inline, string, list and object are held by proxy as entity does.
+	// compact_entity has accessors of entity, with differences:
+	//     as_list() and as_object() return list and object of compact_entity;
+	//     get<character>() returns character by value, get_if<character>() is not provided, use get_opt;
+	//     at() returns pointer to entity instead of refer, nullptr if no value.
+	// use make_compact_entity and to_entity to convert between entity and compact_entity.
+	// it is 24 bytes with PDN_Macro_entity_memory_resource, as proxy holds its memory resource.
+	template <typename char_t = unicode::u8char_t>
+	class compact_entity
+	{
+	public:
+		using char_type    = char_t;
+		using index_type   = ::std::size_t;
+		using key_type     = ::std::basic_string_view<char_type>;
+		using i8           = type::i8;
+		using i16          = type::i16;
+		using i32          = type::i32;
+		using i64          = type::i64;
+		using u8           = type::u8;
+		using u16          = type::u16;
+		using u32          = type::u32;
+		using u64          = type::u64;
+		using f32          = type::f32;
+		using f64          = type::f64;
+		using boolean      = type::boolean;
+		using character    = type::character<char_type>;
+		using string       = type::string<char_type>;
+		using list         = type::compact_list<char_type>;
+		using object       = type::compact_object<char_type>;
+		using string_proxy = proxy<string>;
+		using list_proxy   = proxy<list>;
+		using object_proxy = proxy<object>;
+	private:
+		using units      = ::std::array<char_type, character::max_size()>;
+		using tag_type   = ::std::uint8_t;
+		using accessor   = detail::as_accessor<char_type>;
+		union storage
+		{
+			i8           i8_v;
+			i16          i16_v;
+			i32          i32_v;
+			i64          i64_v;
+			u8           u8_v;
+			u16          u16_v;
+			u32          u32_v;
+			u64          u64_v;
+			f32          f32_v;
+			f64          f64_v;
+			boolean      bool_v;
+			units        char_v;
+			string_proxy string_v;
+			list_proxy   list_v;
+			object_proxy object_v;
+			storage() noexcept : i32_v{} {}
+			~storage() {}
+		};
+	public:
+		// type code of value held
+		auto code() const noexcept -> type_code
+		{
+			return static_cast<type_code>(tag);
+		}
+
+		// calls f with value held as std::visit does with entity,
+		// character is passed by value, string, list and object are passed by their proxies
+		template <typename f_t>
+		decltype(auto) visit(f_t&& f) const
+		{
+			return dispatch(code(), [&]<typename t>(::std::type_identity<t>) -> decltype(auto)
+			{
+				if constexpr (::std::same_as<t, units>)
+				{
+					return ::std::forward<f_t>(f)(get_char());
+				}
+				else
+				{
+					return ::std::forward<f_t>(f)(stored<t>(val));
+				}
+			});
+		}
+
+		template <typename target_t>
+		[[nodiscard]] decltype(auto) as() const
+		{
+			using real_type = detail::tag_to_type_t<target_t, char_type>;
+			if constexpr (type::concepts::pdn_sint<real_type>)
+			{
+				return as_int(real_type{});
+			}
+			else if constexpr (type::concepts::pdn_uint<real_type>)
+			{
+				return as_uint(real_type{});
+			}
+			else if constexpr (type::concepts::pdn_fp<real_type>)
+			{
+				return as_fp(real_type{});
+			}
+			else if constexpr (::std::same_as<real_type, boolean>)
+			{
+				return as_bool();
+			}
+			else if constexpr (::std::same_as<real_type, character>)
+			{
+				return as_char();
+			}
+			else if constexpr (::std::same_as<real_type, type::u8char>)
+			{
+				return as_u8char();
+			}
+			else if constexpr (::std::same_as<real_type, type::u16char>)
+			{
+				return as_u16char();
+			}
+			else if constexpr (::std::same_as<real_type, type::u32char>)
+			{
+				return as_u32char();
+			}
+			else if constexpr (::std::same_as<real_type, string>)
+			{
+				return as_string();
+			}
+			else if constexpr (::std::same_as<real_type, type::u8string>)
+			{
+				return as_u8string();
+			}
+			else if constexpr (::std::same_as<real_type, type::u16string>)
+			{
+				return as_u16string();
+			}
+			else if constexpr (::std::same_as<real_type, type::u32string>)
+			{
+				return as_u32string();
+			}
+			else if constexpr (::std::same_as<real_type, type::list<char_type>> || ::std::same_as<real_type, list>)
+			{
+				return as_list();
+			}
+			else if constexpr (::std::same_as<real_type, type::object<char_type>> || ::std::same_as<real_type, object>)
+			{
+				return as_object();
+			}
+			else
+			{
+				static_assert(false, "[pdn] unsupported type for as<T>(compact_entity)");
+			}
+		}
+
+		template <detail::as_tparam tag_t>
+		[[nodiscard]] decltype(auto) as(tag_t) const
+		{
+			return as<tag_t>();
+		}
+
+		[[nodiscard]] auto as_int() const -> detail::as_int_default_t
+		{
+			return as_int(detail::as_int_default_t{});
+		}
+
+		template <detail::sint_or_tag in>
+		[[nodiscard]] auto as_int(in) const -> detail::as_rttype_t<in, char_type>
+		{
+			return visit([]<typename arg_t>(const arg_t& v)
+			{
+				return detail::as_int<arg_t, detail::tag_to_type_t<in, char_type>>(v);
+			});
+		}
+
+		[[nodiscard]] auto as_uint() const -> detail::as_uint_default_t
+		{
+			return as_uint(detail::as_uint_default_t{});
+		}
+
+		template <detail::uint_or_tag un>
+		[[nodiscard]] auto as_uint(un) const -> detail::as_rttype_t<un, char_type>
+		{
+			return visit([]<typename arg_t>(const arg_t& v)
+			{
+				return detail::as_uint<arg_t, detail::tag_to_type_t<un, char_type>>(v);
+			});
+		}
+
+		[[nodiscard]] auto as_fp() const -> detail::as_fp_default_t
+		{
+			return as_fp(detail::as_fp_default_t{});
+		}
+
+		template <detail::fp_or_tag fn>
+		[[nodiscard]] auto as_fp(fn) const -> detail::as_rttype_t<fn, char_type>
+		{
+			return visit([]<typename arg_t>(const arg_t& v)
+			{
+				return detail::as_fp<arg_t, detail::tag_to_type_t<fn, char_type>>(v);
+			});
+		}
+
+		[[nodiscard]] auto as_bool() const -> boolean
+		{
+			return visit([](const auto& v) { return accessor::as_bool(v); });
+		}
+
+		[[nodiscard]] auto as_char() const -> character
+		{
+			return tag == tag_of<units>() ? get_char() : character{};
+		}
+
+		[[nodiscard]] auto as_u8char() const -> type::u8char
+		{
+			return convert_char<type::u8char, type::u8string>();
+		}
+
+		[[nodiscard]] auto as_u16char() const -> type::u16char
+		{
+			return convert_char<type::u16char, type::u16string>();
+		}
+
+		[[nodiscard]] auto as_u32char() const -> type::u32char
+		{
+			return convert_char<type::u32char, type::u32string>();
+		}
+
+		[[nodiscard]] auto as_string() const -> const string&
+		{
+			return tag == tag_of<string_proxy>() ? *val.string_v : accessor::null_string_val();
+		}
+
+		[[nodiscard]] auto as_u8string() const -> detail::as_rttype_t<type::u8string, char_type>
+		{
+			return convert_string<type::u8string>();
+		}
+
+		[[nodiscard]] auto as_u16string() const -> detail::as_rttype_t<type::u16string, char_type>
+		{
+			return convert_string<type::u16string>();
+		}
+
+		[[nodiscard]] auto as_u32string() const -> detail::as_rttype_t<type::u32string, char_type>
+		{
+			return convert_string<type::u32string>();
+		}
+
+		[[nodiscard]] auto as_list() const -> const list&
+		{
+			static const auto null_val = list{};
+			return tag == tag_of<list_proxy>() ? *val.list_v : null_val;
+		}
+
+		[[nodiscard]] auto as_object() const -> const object&
+		{
+			static const auto null_val = object{};
+			return tag == tag_of<object_proxy>() ? *val.object_v : null_val;
+		}
+
+		// get_opt is for basic type only, returns std::nullopt if type mismatch
+		template <typename target_t>
+		[[nodiscard]] auto get_opt() const -> ::std::optional<target_t>
+		{
+			static_assert(type::concepts::basic_type<target_t, char_type>, "requires pdn basic type");
+			if (tag != tag_of<stored_type<target_t>>())
+			{
+				return ::std::nullopt;
+			}
+			if constexpr (::std::same_as<target_t, character>)
+			{
+				return get_char();
+			}
+			else
+			{
+				return stored<target_t>(val);
+			}
+		}
+
+		// test if the entity holds a value of type target_t
+		template <typename target_t>
+		[[nodiscard]] bool type_test() const noexcept
+		{
+			return tag == tag_of<stored_type<target_t>>();
+		}
+
+		template <typename target_t>
+		[[nodiscard]] decltype(auto) get() const&
+		{
+			check<target_t>();
+			if constexpr (::std::same_as<target_t, character>)
+			{
+				return get_char();
+			}
+			else if constexpr (detail::has_proxy_v<target_t> || ::std::same_as<target_t, list> || ::std::same_as<target_t, object>)
+			{
+				return static_cast<const target_t&>(*stored<stored_type<target_t>>(val));
+			}
+			else
+			{
+				return static_cast<const target_t&>(stored<target_t>(val));
+			}
+		}
+
+		template <typename target_t>
+		[[nodiscard]] decltype(auto) get() &
+		{
+			check<target_t>();
+			if constexpr (::std::same_as<target_t, character>)
+			{
+				return get_char();
+			}
+			else if constexpr (detail::has_proxy_v<target_t> || ::std::same_as<target_t, list> || ::std::same_as<target_t, object>)
+			{
+				return static_cast<target_t&>(*stored<stored_type<target_t>>(val));
+			}
+			else
+			{
+				return static_cast<target_t&>(stored<target_t>(val));
+			}
+		}
+
+		template <typename target_t>
+		[[nodiscard]] decltype(auto) get() &&
+		{
+			if constexpr (::std::same_as<target_t, character>)
+			{
+				return get<target_t>();
+			}
+			else
+			{
+				return ::std::move(get<target_t>());
+			}
+		}
+
+		template <typename target_t>
+		[[nodiscard]] auto get_if() const& -> const target_t*
+		{
+			return const_cast<compact_entity&>(*this).get_if<target_t>();
+		}
+
+		template <typename target_t>
+		[[nodiscard]] auto get_if() & -> target_t*
+		{
+			static_assert(!::std::same_as<target_t, character>, "[pdn] character is held as code units, use get_opt<character>()");
+			if (tag != tag_of<stored_type<target_t>>())
+			{
+				return nullptr;
+			}
+			if constexpr (detail::has_proxy_v<target_t> || ::std::same_as<target_t, list> || ::std::same_as<target_t, object>)
+			{
+				return stored<stored_type<target_t>>(val).get();
+			}
+			else
+			{
+				return &stored<target_t>(val);
+			}
+		}
+
+		template <typename target_t>
+		auto get_if() && -> target_t* = delete;
+
+		template <typename target_t>
+		auto get_if() const&& -> const target_t* = delete;
+
+		auto at(index_type index) const -> const compact_entity*
+		{
+			return const_cast<compact_entity&>(*this).at(index);
+		}
+		auto at(index_type index) -> compact_entity*
+		{
+			if (auto l = get_if<list>(); l && index < l->size())
+			{
+				return &(*l)[index];
+			}
+			return nullptr;
+		}
+
+		auto at(const key_type key) const -> const compact_entity*
+		{
+			return const_cast<compact_entity&>(*this).at(key);
+		}
+		auto at(const key_type key) -> compact_entity*
+		{
+			if (auto o = get_if<object>())
+			{
+				if (auto it = o->find(key); it != o->end())
+				{
+					return &it->second;
+				}
+			}
+			return nullptr;
+		}
+
+		auto operator[](index_type index) const& -> const compact_entity&
+		{
+			return get<list>()[index];
+		}
+		auto operator[](index_type index) & -> compact_entity&
+		{
+			return get<list>()[index];
+		}
+		auto operator[](index_type index) && -> compact_entity&&
+		{
+			return ::std::move((*this)[index]);
+		}
+
+		auto operator[](const key_type key) const& -> const compact_entity&
+		{
+			if (auto p = at(key))
+			{
+				return *p;
+			}
+			throw ::std::out_of_range{ "out_of_range" };
+		}
+		auto operator[](const key_type key) & -> compact_entity&
+		{
+			if (auto p = at(key))
+			{
+				return *p;
+			}
+			throw ::std::out_of_range{ "out_of_range" };
+		}
+		auto operator[](const key_type key) && -> compact_entity&&
+		{
+			return ::std::move((*this)[key]);
+		}
+
+		friend auto operator==(const compact_entity& lhs, const compact_entity& rhs) -> bool
+		{
+			if (lhs.tag != rhs.tag)
+			{
+				return false; // type mismatch, not equal
+			}
+			return dispatch(lhs.code(), [&]<typename t>(::std::type_identity<t>)
+			{
+				if constexpr (::std::same_as<t, units>)
+				{
+					return lhs.get_char() == rhs.get_char();
+				}
+				else if constexpr (::std::same_as<t, string_proxy> || ::std::same_as<t, list_proxy> || ::std::same_as<t, object_proxy>)
+				{
+					return *stored<t>(lhs.val) == *stored<t>(rhs.val);
+				}
+				else
+				{
+					return stored<t>(lhs.val) == stored<t>(rhs.val);
+				}
+			});
+		}
+
+	public:
+		compact_entity() noexcept = default;
+		template <typename t> requires type::concepts::pdn_integral<t> || type::concepts::pdn_fp<t> || type::concepts::pdn_bool<t>
+		compact_entity(t v) noexcept
+		{
+			::new (&stored<t>(val)) t(v);
+			tag = tag_of<t>();
+		}
+		compact_entity(character c) noexcept
+		{
+			auto& u = *::new (&val.char_v) units{};
+			for (::std::size_t i = 0; i < c.size(); ++i)
+			{
+				u[i] = c.data()[i];
+			}
+			tag       = tag_of<units>();
+			char_size = static_cast<tag_type>(c.size());
+		}
+		compact_entity(string s) : compact_entity{ make_proxy<string>(::std::move(s)) } {}
+		compact_entity(list l)   : compact_entity{ make_proxy<list>(::std::move(l)) } {}
+		compact_entity(object o) : compact_entity{ make_proxy<object>(::std::move(o)) } {}
+		template <typename proxy_t> requires ::std::same_as<proxy_t, string_proxy> || ::std::same_as<proxy_t, list_proxy> || ::std::same_as<proxy_t, object_proxy>
+		compact_entity(proxy_t p) noexcept
+		{
+			::new (&stored<proxy_t>(val)) proxy_t(::std::move(p));
+			tag = tag_of<proxy_t>();
+		}
+		compact_entity(const compact_entity& o)
+		{
+			dispatch(o.code(), [&]<typename t>(::std::type_identity<t>)
+			{
+				::new (&stored<t>(val)) t(stored<t>(o.val));
+			});
+			tag       = o.tag;
+			char_size = o.char_size;
+		}
+		compact_entity(compact_entity&& o) noexcept
+		{
+			dispatch(o.code(), [&]<typename t>(::std::type_identity<t>)
+			{
+				::new (&stored<t>(val)) t(::std::move(stored<t>(o.val)));
+			});
+			tag       = o.tag;
+			char_size = o.char_size;
+		}
+		compact_entity& operator=(const compact_entity& o)
+		{
+			if (this != &o)
+			{
+				*this = compact_entity{ o };
+			}
+			return *this;
+		}
+		compact_entity& operator=(compact_entity&& o) noexcept
+		{
+			if (this != &o)
+			{
+				destroy();
+				::new (this) compact_entity(::std::move(o));
+			}
+			return *this;
+		}
+		~compact_entity()
+		{
+			destroy();
+		}
+	private:
+		// stored type of target type, character is stored as its code units
+		template <typename target_t>
+		struct stored_type_of { using type = target_t; };
+		template <typename target_t> requires ::std::same_as<target_t, character>
+		struct stored_type_of<target_t> { using type = units; };
+		template <typename target_t> requires ::std::same_as<target_t, string>
+		struct stored_type_of<target_t> { using type = string_proxy; };
+		template <typename target_t> requires ::std::same_as<target_t, list>
+		struct stored_type_of<target_t> { using type = list_proxy; };
+		template <typename target_t> requires ::std::same_as<target_t, object>
+		struct stored_type_of<target_t> { using type = object_proxy; };
+		template <typename target_t>
+		using stored_type = typename stored_type_of<target_t>::type;
+
+		template <typename t>
+		static constexpr auto tag_of() noexcept -> tag_type
+		{
+			if constexpr (::std::same_as<t, i8>)                return tag_type(type_code::i8);
+			else if constexpr (::std::same_as<t, i16>)          return tag_type(type_code::i16);
+			else if constexpr (::std::same_as<t, i32>)          return tag_type(type_code::i32);
+			else if constexpr (::std::same_as<t, i64>)          return tag_type(type_code::i64);
+			else if constexpr (::std::same_as<t, u8>)           return tag_type(type_code::u8);
+			else if constexpr (::std::same_as<t, u16>)          return tag_type(type_code::u16);
+			else if constexpr (::std::same_as<t, u32>)          return tag_type(type_code::u32);
+			else if constexpr (::std::same_as<t, u64>)          return tag_type(type_code::u64);
+			else if constexpr (::std::same_as<t, f32>)          return tag_type(type_code::f32);
+			else if constexpr (::std::same_as<t, f64>)          return tag_type(type_code::f64);
+			else if constexpr (::std::same_as<t, boolean>)      return tag_type(type_code::boolean);
+			else if constexpr (::std::same_as<t, units>)        return tag_type(type_code::character);
+			else if constexpr (::std::same_as<t, string_proxy>) return tag_type(type_code::string);
+			else if constexpr (::std::same_as<t, list_proxy>)   return tag_type(type_code::list);
+			else if constexpr (::std::same_as<t, object_proxy>) return tag_type(type_code::object);
+			else                                                return tag_type(type_code::unknown); // never held
+		}
+
+		template <typename t, typename storage_t>
+		static auto stored(storage_t& v) noexcept -> auto&
+		{
+			if constexpr (::std::same_as<t, i8>)                return v.i8_v;
+			else if constexpr (::std::same_as<t, i16>)          return v.i16_v;
+			else if constexpr (::std::same_as<t, i32>)          return v.i32_v;
+			else if constexpr (::std::same_as<t, i64>)          return v.i64_v;
+			else if constexpr (::std::same_as<t, u8>)           return v.u8_v;
+			else if constexpr (::std::same_as<t, u16>)          return v.u16_v;
+			else if constexpr (::std::same_as<t, u32>)          return v.u32_v;
+			else if constexpr (::std::same_as<t, u64>)          return v.u64_v;
+			else if constexpr (::std::same_as<t, f32>)          return v.f32_v;
+			else if constexpr (::std::same_as<t, f64>)          return v.f64_v;
+			else if constexpr (::std::same_as<t, boolean>)      return v.bool_v;
+			else if constexpr (::std::same_as<t, units>)        return v.char_v;
+			else if constexpr (::std::same_as<t, string_proxy>) return v.string_v;
+			else if constexpr (::std::same_as<t, list_proxy>)   return v.list_v;
+			else if constexpr (::std::same_as<t, object_proxy>) return v.object_v;
+			else static_assert(false, "[pdn] type is not held by compact_entity");
+		}
+
+		// calls f with std::type_identity of stored type of c
+		template <typename f_t>
+		static decltype(auto) dispatch(type_code c, f_t&& f)
+		{
+			switch (c)
+			{
+			case type_code::i8:        return f(::std::type_identity<i8>{});
+			case type_code::i16:       return f(::std::type_identity<i16>{});
+			case type_code::i64:       return f(::std::type_identity<i64>{});
+			case type_code::u8:        return f(::std::type_identity<u8>{});
+			case type_code::u16:       return f(::std::type_identity<u16>{});
+			case type_code::u32:       return f(::std::type_identity<u32>{});
+			case type_code::u64:       return f(::std::type_identity<u64>{});
+			case type_code::f32:       return f(::std::type_identity<f32>{});
+			case type_code::f64:       return f(::std::type_identity<f64>{});
+			case type_code::boolean:   return f(::std::type_identity<boolean>{});
+			case type_code::character: return f(::std::type_identity<units>{});
+			case type_code::string:    return f(::std::type_identity<string_proxy>{});
+			case type_code::list:      return f(::std::type_identity<list_proxy>{});
+			case type_code::object:    return f(::std::type_identity<object_proxy>{});
+			default:                   return f(::std::type_identity<i32>{});
+			}
+		}
+
+		template <typename target_t>
+		void check() const
+		{
+			if (tag != tag_of<stored_type<target_t>>())
+			{
+				throw ::std::bad_variant_access{};
+			}
+		}
+
+		auto get_char() const noexcept -> character
+		{
+			return character{ val.char_v.data(), char_size };
+		}
+
+		template <typename char_type_t, typename string_t>
+		auto convert_char() const -> char_type_t
+		{
+			if constexpr (::std::same_as<char_type_t, character>)
+			{
+				return as_char();
+			}
+			else
+			{
+				auto converted = unicode::code_convert<string_t>(as_char().to_string_view());
+				return char_type_t{ converted.cbegin(), converted.size() };
+			}
+		}
+
+		template <typename string_t>
+		auto convert_string() const -> detail::as_rttype_t<string_t, char_type>
+		{
+			if constexpr (::std::same_as<string_t, string>)
+			{
+				return as_string();
+			}
+			else
+			{
+				return unicode::code_convert<string_t>(as_string());
+			}
+		}
+
+		void destroy() noexcept
+		{
+			dispatch(code(), [&]<typename t>(::std::type_identity<t>)
+			{
+				stored<t>(val).~t();
+			});
+		}
+	private:
+		storage  val{};
+		tag_type tag{ tag_of<i32>() };
+		tag_type char_size{};
+	};
+
+	static_assert(type::config::entity_memory_resource || sizeof(compact_entity<unicode::u8char_t>)  == 16);
+	static_assert(type::config::entity_memory_resource || sizeof(compact_entity<unicode::u16char_t>) == 16);
+	static_assert(type::config::entity_memory_resource || sizeof(compact_entity<unicode::u32char_t>) == 16);
+
+	using u8compact_entity  = compact_entity<char8_t>;
+	using u16compact_entity = compact_entity<char16_t>;
+	using u32compact_entity = compact_entity<char32_t>;
+}
+
+namespace pdn
+{
+	// converts entity to compact_entity, pass entity by move to move strings instead of copying them
+	template <typename char_t>
+	[[nodiscard]] auto make_compact_entity(entity<char_t> e) -> compact_entity<char_t>
+	{
+		using result_type = compact_entity<char_t>;
+		return ::std::visit([]<typename arg_t>(arg_t& v) -> result_type
+		{
+			if constexpr (::std::same_as<arg_t, proxy<type::list<char_t>>>)
+			{
+				auto l = typename result_type::list{};
+				l.reserve(v->size());
+				for (auto& element : *v)
+				{
+					l.push_back(make_compact_entity(::std::move(element)));
+				}
+				return result_type{ ::std::move(l) };
+			}
+			else if constexpr (::std::same_as<arg_t, proxy<type::packed_list>>) // to list of its elements
+			{
+				auto l = typename result_type::list{};
+				l.reserve(v->size());
+				v->visit([&](auto elements)
+				{
+					for (auto element : elements)
+					{
+						l.push_back(result_type{ element });
+					}
+				});
+				return result_type{ ::std::move(l) };
+			}
+			else if constexpr (::std::same_as<arg_t, proxy<type::object<char_t>>>)
+			{
+				auto o = typename result_type::object{};
+				for (auto& [key, value] : *v)
+				{
+					o[key] = make_compact_entity(::std::move(value));
+				}
+				return result_type{ ::std::move(o) };
+			}
+			else
+			{
+				return result_type{ ::std::move(v) };
+			}
+		}, e);
+	}
+
+	// converts compact_entity to entity, pass compact_entity by move to move strings instead of copying them
+	template <typename char_t>
+	[[nodiscard]] auto to_entity(compact_entity<char_t> e) -> entity<char_t>
+	{
+		using result_type = entity<char_t>;
+		if (auto l = e.template get_if<typename compact_entity<char_t>::list>())
+		{
+			auto result = type::list<char_t>{};
+			result.reserve(l->size());
+			for (auto& element : *l)
+			{
+				result.push_back(to_entity(::std::move(element)));
+			}
+			return result_type{ make_proxy<type::list<char_t>>(::std::move(result)) };
+		}
+		if (auto o = e.template get_if<typename compact_entity<char_t>::object>())
+		{
+			auto result = type::object<char_t>{};
+			for (auto& [key, value] : *o)
+			{
+				result[key] = to_entity(::std::move(value));
+			}
+			return result_type{ make_proxy<type::object<char_t>>(::std::move(result)) };
+		}
+		if (auto s = e.template get_if<type::string<char_t>>())
+		{
+			return result_type{ make_proxy<type::string<char_t>>(::std::move(*s)) };
+		}
+		return e.visit([]<typename arg_t>(const arg_t& v) -> result_type
+		{
+			if constexpr (detail::has_proxy_v<remove_proxy_t<arg_t>>
+			           || ::std::same_as<remove_proxy_t<arg_t>, typename compact_entity<char_t>::list>
+			           || ::std::same_as<remove_proxy_t<arg_t>, typename compact_entity<char_t>::object>)
+			{
+				return result_type{}; // handled above
+			}
+			else
+			{
+				return result_type{ v };
+			}
+		});
+	}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef PDN_Header_pdn_dfa_transition_table
+#define PDN_Header_pdn_dfa_transition_table
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <limits>
+
+#include "pdn_unicode_base.h"
+#include "pdn_dfa_state_code.h"
+#include "pdn_dfa_state_object.h"
+#include "pdn_dfa_state_objects.h"
+
+namespace pdn
+{
+	// transition table of lexer dfa for code points in range [0, 0x80),
+	// one table load per ASCII code point instead of an indirect call of transformer.
+	// dfa_state_objects are the specification of dfa, table is generated from their transformers once,
+	// so transform(state, c) is always same as state.transformer(c).
+	// other code points (such as characters of identifier) are still transformed by transformer.
+	class dfa_transition_table
+	{
+	public:
+		using size_type = ::std::size_t;
+		static constexpr size_type state_count{ static_cast<size_type>(dfa_state_code::question_mark) + 1 };
+		static constexpr size_type ascii_count{ 0x80 };
+		static_assert(state_count <= ::std::numeric_limits<::std::uint8_t>::max(), "[pdn] dfa_transition_table error: too many dfa states");
+	public:
+		dfa_state_object transform(const dfa_state_object& state, unicode::code_point_t c) const noexcept
+		{
+			if (c < ascii_count) [[likely]]
+			{
+				return states[next_states[static_cast<size_type>(state.state_code)][c]];
+			}
+			return state.transformer(c);
+		}
+		static const dfa_transition_table& instance()
+		{
+			static const dfa_transition_table table{};
+			return table;
+		}
+	private:
+		void add_state(const dfa_state_object& state) noexcept
+		{
+			const auto index = static_cast<size_type>(state.state_code);
+			states[index] = state;
+			for (size_type c{}; c < ascii_count; ++c)
+			{
+				// states without transformer are never current state of dfa, they are transformed by lexer
+				const auto next = state.transformer != nullptr ? state.transformer(unicode::code_point_t(c)) : dfa_state_objects::unmatched;
+				next_states[index][c] = static_cast<::std::uint8_t>(next.state_code);
+			}
+		}
+		dfa_transition_table() noexcept
+		{
+			using namespace dfa_state_objects;
+			for (const auto* state : {
+				&unmatched, &unacceptable_character, &start, &infinity,
+				&identifier, &identifier_string_opened, &identifier_string, &identifier_string_closed,
+				&identifier_string_escape, &identifier_string_with_LF,
+				&slash, &line_comment, &block_comment, &block_comment_closing,
+				&less_than, &nested_block_comment, &nested_block_comment_nesting, &nested_block_comment_nested,
+				&nested_block_comment_closing, &nested_block_comment_closed,
+				&string_opened, &string, &string_closed, &string_escape, &string_with_LF,
+				&character_opened, &character, &character_closed, &character_escape, &character_with_LF,
+				&at_sign, &at_identifier,
+				&raw_string_d_seq_opened, &raw_string, &raw_string_received_CR,
+				&raw_string_received_right_parentheses, &raw_string_closed,
+				&identifier_raw_string_d_seq_opened, &identifier_raw_string, &identifier_raw_string_received_CR,
+				&identifier_raw_string_received_right_parentheses, &identifier_raw_string_closed,
+				&dec_seq, &dec_seq_with_quote, &fp_dec_part_first_after_dec_with_dot, &fp_dec_part,
+				&fp_dec_part_with_quote, &fp_exp_sign_or_first, &fp_exp_first, &fp_exp, &fp_exp_with_quote,
+				&zero, &oct_seq, &oct_seq_with_quote, &dec_seq_start_with_0, &dec_seq_start_with_0_with_quote,
+				&bin_seq_first, &bin_seq, &bin_seq_with_quote,
+				&hex_seq_first, &hex_seq, &hex_seq_with_quote,
+				&hex_fp_dec_part_first_after_hex_with_dot, &hex_fp_dec_part, &hex_fp_dec_part_with_quote,
+				&hex_fp_exp_sign_or_first, &hex_fp_exp_first, &hex_fp_exp, &hex_fp_exp_with_quote,
+				&hex_fp_seq_start_with_0x_dot,
+				&dot, &tilde, &exclamation_mark, &hash, &dollar, &percent, &caret, &ampersand, &asterisk,
+				&left_parentheses, &right_parentheses, &left_brackets, &right_brackets,
+				&left_curly_brackets, &right_curly_brackets, &minus, &plus, &equal, &back_slash, &bar,
+				&colon, &semicolon, &greater_than, &comma, &question_mark })
+			{
+				add_state(*state);
+			}
+			// every state reached by transformer must be registered above
+			for ([[maybe_unused]] const auto& row : next_states)
+			{
+				for ([[maybe_unused]] auto next : row)
+				{
+					assert(states[next].state_code == dfa_state_code(next) && "[pdn] dfa_transition_table error: unregistered dfa state");
+				}
+			}
+		}
+	private:
+		::std::array<dfa_state_object, state_count>                              states{};      // state object of each state code
+		::std::array<::std::array<::std::uint8_t, ascii_count>, state_count>     next_states{}; // [state code][code point] -> next state code
+	};
+
+	// lexer dfa driven by transformers of dfa_state_objects for every code point, as lexer was before the table.
+	// it is the reference engine dfa_transition_table is checked against, lexer<char_t, fn_pkg, dfa_transformer_engine> uses it.
+	class dfa_transformer_engine
+	{
+	public:
+		dfa_state_object transform(const dfa_state_object& state, unicode::code_point_t c) const noexcept
+		{
+			return state.transformer(c);
+		}
+		static const dfa_transformer_engine& instance()
+		{
+			static const dfa_transformer_engine engine{};
+			return engine;
+		}
+	};
+}
+
+#endif
@@ -6,8 +6,10 @@
 #include <utility>
 #include <variant>
 #include <cstddef>
+#include <algorithm>
 #include <string>
 #include <optional>
+#include <span>
 #include <stdexcept>
 
 #include "pdn_type.h"
@@ -64,10 +66,15 @@ namespace pdn::detail
 
 		[[nodiscard]] auto as_u32string() const -> type::u32string;
 
+		// as_list is empty list for packed list, its elements are read by as_span
 		[[nodiscard]] auto as_list() const -> const type::list<char_type>&;
 
 		[[nodiscard]] auto as_object() const -> const type::object<char_type>&;
 
+		// elements of packed list of target_t, empty if the entity is not packed list or its type mismatch
+		template <typename target_t>
+		[[nodiscard]] auto as_span() const -> ::std::span<const target_t>;
+
 		// get_opt is for basic type only, returns std::nullopt if type mismatch or no value
 		template <typename target_t>
 		[[nodiscard]] auto get_opt() const -> ::std::optional<target_t>;
@@ -220,12 +227,13 @@ namespace pdn
 		auto cref() const&& -> const_refer<char_type> = delete;
 		auto cref() const&  -> const_refer<char_type> { return const_refer<char_type>{ *this }; }
 
+		// element of list, empty refer for packed list, whose elements are read by as_span or made entities by unpack
 		auto at(index_type) const&& ->const_refer<char_type> = delete;
 		auto at(index_type index) const& -> const_refer<char_type>
 		{
 			if (auto prp = ::std::get_if<list_proxy>(this); prp) // pointer to proxy of list
 			{
-				if (list& arr = **prp; index < arr.size())
+				if (const list& arr = **prp; index < arr.size())
 				{
 					return const_refer<char_type>{ arr[index] };
 				}
@@ -249,7 +257,7 @@ namespace pdn
 		{
 			if (auto prp = ::std::get_if<object_proxy>(this); prp) // pointer to proxy of object
 			{
-				object& o = **prp;
+				const object& o = **prp;
 				if (auto it = o.find(key); it != o.end())
 				{
 					return const_refer<char_type>{ it->second };
@@ -309,7 +317,26 @@ namespace pdn
 		}
 
 	};
+}
+
+namespace pdn::detail
+{
+	// packed list equals list of same elements
+	template <typename char_t>
+	auto packed_equal(const type::packed_list& lhs, const type::list<char_t>& rhs) -> bool
+	{
+		return lhs.visit([&](auto elements)
+		{
+			return ::std::equal(elements.begin(), elements.end(), rhs.begin(), rhs.end(), [](auto v, const entity<char_t>& e)
+			{
+				return e == entity<char_t>{ v };
+			});
+		});
+	}
+}
 
+namespace pdn
+{
 	template <typename char_t>
 	auto operator==(const entity<char_t>& lhs, const entity<char_t>& rhs) -> bool
 	{
@@ -322,7 +349,8 @@ namespace pdn
 				constexpr auto is_proxy =
 					::std::same_as<v1t, proxy<type::string<char_t>>> ||
 					::std::same_as<v1t, proxy<type::list  <char_t>>> ||
-					::std::same_as<v1t, proxy<type::object<char_t>>>;
+					::std::same_as<v1t, proxy<type::object<char_t>>> ||
+					::std::same_as<v1t, proxy<type::packed_list>>;
 				if constexpr (is_proxy)
 				{
 					return *v1 == *v2;
@@ -332,6 +360,14 @@ namespace pdn
 					return v1 == v2;
 				}
 			}
+			else if constexpr (::std::same_as<v1t, proxy<type::packed_list>> && ::std::same_as<v2t, proxy<type::list<char_t>>>)
+			{
+				return detail::packed_equal(*v1, *v2);
+			}
+			else if constexpr (::std::same_as<v1t, proxy<type::list<char_t>>> && ::std::same_as<v2t, proxy<type::packed_list>>)
+			{
+				return detail::packed_equal(*v2, *v1);
+			}
 			else
 			{
 				return false; // type mismatch, not equal
@@ -584,6 +620,17 @@ namespace pdn
 		return ::std::visit([](const auto& v) -> decltype(auto) { return detail::as_accessor<char_t>::as_object(v); }, e);
 	}
 
+	// as_span<pdn::type::i32/.../f64/boolean>(entity), empty if entity is not packed list of the type
+	template <typename target_t, typename char_t>
+	[[nodiscard]] auto as_span(const entity<char_t>& e) -> ::std::span<const target_t>
+	{
+		if (auto p = ::std::get_if<proxy<type::packed_list>>(&e))
+		{
+			return (*p)->template as_span<target_t>();
+		}
+		return {};
+	}
+
 	template <detail::sint_or_tag in, typename char_t>
 	[[nodiscard]] auto as_int(const_refer<char_t> e, in tag) -> detail::as_rttype_t<in, char_t>
 	{
@@ -686,6 +733,12 @@ namespace pdn
 		return e ? as_object(*e) : detail::as_accessor<char_t>::null_object_val();
 	}
 
+	template <typename target_t, typename char_t>
+	[[nodiscard]] auto as_span(const_refer<char_t> e) -> ::std::span<const target_t>
+	{
+		return e ? as_span<target_t>(*e) : ::std::span<const target_t>{};
+	}
+
 	template <typename target_t, typename char_t> requires detail::as_tparam_pure<target_t, char_t>
 	[[nodiscard]] auto as(const entity<char_t>& e) -> detail::as_rttype_t<target_t, char_t>
 	{
@@ -938,6 +991,26 @@ namespace pdn
 	{
 		return get_if<target_t>(e);
 	}
+
+	// replaces packed list by list of its elements, so they are accessed as entities (by at, as_list, ...),
+	// other entity is not changed
+	template <typename char_t>
+	void unpack(entity<char_t>& e)
+	{
+		if (auto p = ::std::get_if<proxy<type::packed_list>>(&e))
+		{
+			auto l = type::list<char_t>{};
+			::std::as_const(*p)->visit([&](auto elements)
+			{
+				l.reserve(elements.size());
+				for (auto v : elements)
+				{
+					l.emplace_back(v);
+				}
+			});
+			e = make_proxy<type::list<char_t>>(::std::move(l));
+		}
+	}
 }
 
 namespace pdn
@@ -1078,6 +1151,13 @@ namespace pdn::detail
 		return pdn::as_object(*static_cast<const entity_t*>(this));
 	}
 
+	template <typename entity_t, typename char_t>
+	template <typename target_t>
+	[[nodiscard]] auto crtp_accessor<entity_t, char_t>::as_span() const -> ::std::span<const target_t>
+	{
+		return pdn::as_span<target_t>(*static_cast<const entity_t*>(this));
+	}
+
 	template <typename entity_t, typename char_t>
 	template <typename target_t>
 	[[nodiscard]] auto crtp_accessor_e<entity_t, char_t>::get() const& -> const target_t&
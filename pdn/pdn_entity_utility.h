@@ -21,7 +21,8 @@ namespace pdn::type::detail
 		character<char_t>,
 		proxy<string<char_t>>,
 		proxy<list<char_t>>,
-		proxy<object<char_t>>>;
+		proxy<object<char_t>>,
+		proxy<packed_list>>;
 }
 
 namespace pdn::detail
@@ -251,6 +252,11 @@ namespace pdn::detail
 	{
 		static constexpr bool value = true;
 	};
+	template <>
+	struct has_proxy<type::packed_list>
+	{
+		static constexpr bool value = true;
+	};
 	template <typename t>
 	inline static constexpr bool has_proxy_v = has_proxy<t>::value;
 }
@@ -61,6 +61,8 @@ namespace pdn::detail
 			return u8"missing right brackets: ]"_em;
 		case missing_right_curly_brackets:
 			return u8"missing right curly brackets: }"_em;
+		case nesting_too_deep:
+			return u8"nesting too deep: list or object exceeds max nesting depth"_em;
 		default:
 			assert(0 && "syntax error and error_message_generator_en unresolved");
 			return u8"syntax error and error_message_generator_en unresolved"_em;
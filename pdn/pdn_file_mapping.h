@@ -0,0 +1,271 @@
+#ifndef PDN_Header_pdn_file_mapping
+#define PDN_Header_pdn_file_mapping
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <limits>
+#include <filesystem>
+
+#if defined(_WIN32)
+#	define PDN_Macro_file_mapping_win32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#		define PDN_Macro_file_mapping_undef_lean_and_mean
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#		define PDN_Macro_file_mapping_undef_nominmax
+#	endif
+#	include <windows.h>
+#	ifdef PDN_Macro_file_mapping_undef_lean_and_mean
+#		undef WIN32_LEAN_AND_MEAN
+#		undef PDN_Macro_file_mapping_undef_lean_and_mean
+#	endif
+#	ifdef PDN_Macro_file_mapping_undef_nominmax
+#		undef NOMINMAX
+#		undef PDN_Macro_file_mapping_undef_nominmax
+#	endif
+#elif defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#	define PDN_Macro_file_mapping_posix
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+//    byte input stream (provide: get byte) // such as ifstream
+//     |
+//     +---> BOM reader (provide: get BOM)
+//     |         extra: requires byte input stream has operation seekg
+//     v
+//    swap chain (provide: get byte)
+// >> or file mapping (provide: contiguous bytes of whole file)
+//     |
+//     v
+//    code unit iterator (provide: get code unit, move backward(++it), check EOF)
+//     |
+//     +---- utf-8 decoder ---+
+//     |                      |
+//     +---- utf-16 decoder --+---- (provide: decode to get unicode code-point)
+//     |                      |
+//     +---- utf-32 decoder --+
+//     v
+//    code point iterator (provide: get code point, move backward(++it), check EOF)
+//     |
+//     v
+//    lexer (provide: get token{ token code, value, token position })
+//     |
+//     v
+//    parser (provide: parse) ----> pdn document object model
+
+namespace pdn::detail
+{
+	// page size of virtual memory, 4096 if it is unknown
+	inline auto system_page_size() noexcept -> ::std::size_t
+	{
+		static const ::std::size_t page_size = []() noexcept -> ::std::size_t
+		{
+#if defined(PDN_Macro_file_mapping_win32)
+			SYSTEM_INFO info{};
+			::GetSystemInfo(&info);
+			return info.dwPageSize != 0 ? static_cast<::std::size_t>(info.dwPageSize) : 4096;
+#elif defined(PDN_Macro_file_mapping_posix)
+			long size = ::sysconf(_SC_PAGESIZE);
+			return size > 0 ? static_cast<::std::size_t>(size) : 4096;
+#else
+			return 4096;
+#endif
+		}();
+		return page_size;
+	}
+}
+
+namespace pdn
+{
+	// read-only view of whole file mapped into memory
+	// the bytes are read from page cache directly, no copy into user space buffer.
+	// is_open() is false when the platform has no mapping support or mapping failed,
+	// callers should fall back to stream input in that case.
+	// note: the file should not be truncated by others while it is mapped.
+	class file_mapping
+	{
+	public:
+		using value_type     = char;
+		using size_type      = ::std::size_t;
+		using const_iterator = const value_type*;
+		using iterator       = const_iterator;
+	public:
+		const value_type* data() const noexcept
+		{
+			return view;
+		}
+		size_type size() const noexcept
+		{
+			return view_size;
+		}
+		bool empty() const noexcept
+		{
+			return view_size == 0;
+		}
+		const_iterator begin() const noexcept
+		{
+			return view;
+		}
+		const_iterator end() const noexcept
+		{
+			return view + view_size;
+		}
+		const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+		const_iterator cend() const noexcept
+		{
+			return end();
+		}
+		bool is_open() const noexcept
+		{
+			return opened;
+		}
+		explicit operator bool() const noexcept
+		{
+			return is_open();
+		}
+		bool open(const ::std::filesystem::path& filename) noexcept
+		{
+			close();
+			opened = map_file(filename);
+			return opened;
+		}
+		void close() noexcept
+		{
+			if (view != nullptr)
+			{
+				unmap_view();
+			}
+			view      = nullptr;
+			view_size = 0;
+			opened    = false;
+		}
+	private:
+#if defined(PDN_Macro_file_mapping_win32)
+		bool map_file(const ::std::filesystem::path& filename) noexcept
+		{
+			HANDLE file = ::CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+			LARGE_INTEGER file_size{};
+			if (!::GetFileSizeEx(file, &file_size)
+			    || static_cast<::std::uint64_t>(file_size.QuadPart) > (::std::numeric_limits<size_type>::max)())
+			{
+				::CloseHandle(file);
+				return false;
+			}
+			if (file_size.QuadPart == 0) // empty file can not be mapped, but it is a valid source
+			{
+				::CloseHandle(file);
+				return true;
+			}
+			HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			::CloseHandle(file); // mapping object holds its own reference to the file
+			if (mapping == nullptr)
+			{
+				return false;
+			}
+			void* address = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			::CloseHandle(mapping); // view holds its own reference to the mapping object
+			if (address == nullptr)
+			{
+				return false;
+			}
+			view      = static_cast<const value_type*>(address);
+			view_size = static_cast<size_type>(file_size.QuadPart);
+			return true;
+		}
+		void unmap_view() noexcept
+		{
+			::UnmapViewOfFile(view);
+		}
+#elif defined(PDN_Macro_file_mapping_posix)
+		bool map_file(const ::std::filesystem::path& filename) noexcept
+		{
+			int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1)
+			{
+				return false;
+			}
+			struct ::stat file_stat{};
+			if (::fstat(fd, &file_stat) != 0
+			    || !S_ISREG(file_stat.st_mode)
+			    || static_cast<::std::uintmax_t>(file_stat.st_size) > (::std::numeric_limits<size_type>::max)())
+			{
+				::close(fd);
+				return false;
+			}
+			if (file_stat.st_size == 0) // empty file can not be mapped, but it is a valid source
+			{
+				::close(fd);
+				return true;
+			}
+			auto file_size = static_cast<size_type>(file_stat.st_size);
+			void* address = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd); // mapping holds its own reference to the file
+			if (address == MAP_FAILED)
+			{
+				return false;
+			}
+			::madvise(address, file_size, MADV_SEQUENTIAL); // lexer reads front to back, advice is optional
+			view      = static_cast<const value_type*>(address);
+			view_size = file_size;
+			return true;
+		}
+		void unmap_view() noexcept
+		{
+			::munmap(const_cast<value_type*>(view), view_size);
+		}
+#else
+		bool map_file(const ::std::filesystem::path&) noexcept
+		{
+			return false; // no mapping support, use stream input
+		}
+		void unmap_view() noexcept {}
+#endif
+	public:
+		file_mapping() = default;
+		explicit file_mapping(const ::std::filesystem::path& filename) noexcept
+		{
+			open(filename);
+		}
+		file_mapping(const file_mapping&) = delete;
+		file_mapping& operator=(const file_mapping&) = delete;
+		file_mapping(file_mapping&& other) noexcept :
+			view{ ::std::exchange(other.view, nullptr) },
+			view_size{ ::std::exchange(other.view_size, 0) },
+			opened{ ::std::exchange(other.opened, false) } {}
+		file_mapping& operator=(file_mapping&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+				view      = ::std::exchange(other.view, nullptr);
+				view_size = ::std::exchange(other.view_size, 0);
+				opened    = ::std::exchange(other.opened, false);
+			}
+			return *this;
+		}
+		~file_mapping()
+		{
+			close();
+		}
+	private:
+		const value_type* view{};      // first byte of mapped view, nullptr when empty or not opened
+		size_type         view_size{}; // size of mapped view in bytes
+		bool              opened{};    // mapped successfully (empty file counts)
+	};
+}
+
+#endif
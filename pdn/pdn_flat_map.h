@@ -0,0 +1,576 @@
+#ifndef PDN_Header_pdn_flat_map
+#define PDN_Header_pdn_flat_map
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <utility>
+#include <memory>
+#include <functional>
+#include <tuple>
+#include <iterator>
+#include <algorithm>
+
+#include <type_traits>
+#include <stdexcept>
+
+#include <vector>
+
+#include "pdn_map_slot.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define PDN_Macro_flat_map_sse2
+#	include <emmintrin.h>
+#endif
+
+namespace pdn::type::detail
+{
+	// control bytes of 16 slots, matched together, sse2 is baseline of x86-64
+	struct flat_map_group
+	{
+		static constexpr ::std::size_t width = 16;
+		static constexpr ::std::uint8_t empty   = 0x80;
+		static constexpr ::std::uint8_t deleted = 0xFE;
+		// full slot holds 7 bits of hash of its key, free slot (empty or deleted) has high bit set
+
+		// bit i is set if control byte i is c
+		static auto match(const ::std::uint8_t* ctrl, ::std::uint8_t c) noexcept -> ::std::uint32_t
+		{
+#if defined(PDN_Macro_flat_map_sse2)
+			auto bytes = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+			return static_cast<::std::uint32_t>(::_mm_movemask_epi8(::_mm_cmpeq_epi8(bytes, ::_mm_set1_epi8(static_cast<char>(c)))));
+#else
+			::std::uint32_t mask{};
+			for (::std::size_t i{}; i < width; ++i)
+			{
+				mask |= ::std::uint32_t(ctrl[i] == c) << i;
+			}
+			return mask;
+#endif
+		}
+
+		// bit i is set if slot i is empty or deleted
+		static auto match_free(const ::std::uint8_t* ctrl) noexcept -> ::std::uint32_t
+		{
+#if defined(PDN_Macro_flat_map_sse2)
+			return static_cast<::std::uint32_t>(::_mm_movemask_epi8(::_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+			::std::uint32_t mask{};
+			for (::std::size_t i{}; i < width; ++i)
+			{
+				mask |= ::std::uint32_t(ctrl[i] >> 7) << i;
+			}
+			return mask;
+#endif
+		}
+	};
+
+	// hash map whose entries are held in one array of slots, found by control bytes holding 7 bits of their hashes,
+	// as swiss table does. members of object are found by touching a group of control bytes and the slot matched,
+	// and object allocates its slots at once instead of allocating a node for each member.
+	// lookup is heterogeneous when hash_t and key_equal_t accept the argument, e.g. string_view for string keys.
+	// order of iteration is unspecified, inserting may invalidate iterators and references as rehashing moves entries.
+	// entries are held in map_slot, so rehashing moves their keys, and iterators hand out values whose keys are const.
+	template <typename key_t,
+	          typename val_t,
+	          typename hash_t      = ::std::hash<key_t>,
+	          typename key_equal_t = ::std::equal_to<>,
+	          typename alloc_t     = ::std::allocator<::std::pair<const key_t, val_t>>>
+	class flat_map
+	{
+	public:
+		using key_type        = key_t;
+		using mapped_type     = val_t;
+		using value_type      = ::std::pair<const key_t, val_t>;
+		using hasher          = hash_t;
+		using key_equal       = key_equal_t;
+		using allocator_type  = alloc_t;
+		using size_type       = ::std::size_t;
+		using difference_type = ::std::ptrdiff_t;
+		using reference       = value_type&;
+		using const_reference = const value_type&;
+	private:
+		using alloc_traits   = ::std::allocator_traits<alloc_t>;
+		using slot_type      = map_slot<key_t, val_t>;
+		using slot_allocator = typename alloc_traits::template rebind_alloc<slot_type>;
+		using slot_traits    = ::std::allocator_traits<slot_allocator>;
+		using ctrl_allocator = typename alloc_traits::template rebind_alloc<::std::uint8_t>;
+		using ctrl_type      = ::std::vector<::std::uint8_t, ctrl_allocator>;
+		using group          = flat_map_group;
+		static constexpr size_type npos = size_type(-1);
+
+		template <bool is_const>
+		class basic_iterator
+		{
+		public:
+			using iterator_category = ::std::forward_iterator_tag;
+			using value_type        = flat_map::value_type;
+			using difference_type   = flat_map::difference_type;
+			using pointer           = ::std::conditional_t<is_const, const value_type*, value_type*>;
+			using reference         = ::std::conditional_t<is_const, const value_type&, value_type&>;
+
+			basic_iterator() = default;
+			template <bool other_const> requires (is_const && !other_const)
+			basic_iterator(const basic_iterator<other_const>& o) : ctrl{ o.ctrl }, ctrl_end{ o.ctrl_end }, slot{ o.slot } {}
+
+			auto operator*()  const -> reference { return slot->value;  }
+			auto operator->() const -> pointer   { return &slot->value; }
+			auto operator++() -> basic_iterator&
+			{
+				++ctrl;
+				++slot;
+				skip_free();
+				return *this;
+			}
+			auto operator++(int) -> basic_iterator
+			{
+				auto result = *this;
+				++*this;
+				return result;
+			}
+			friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+			{
+				return lhs.slot == rhs.slot;
+			}
+		private:
+			friend class flat_map;
+			template <bool>
+			friend class basic_iterator;
+			const ::std::uint8_t* ctrl{};
+			const ::std::uint8_t* ctrl_end{};
+			slot_type*            slot{};
+
+			basic_iterator(const ::std::uint8_t* ctrl, const ::std::uint8_t* ctrl_end, slot_type* slot) noexcept :
+				ctrl{ ctrl }, ctrl_end{ ctrl_end }, slot{ slot }
+			{
+				skip_free();
+			}
+			void skip_free() noexcept
+			{
+				for (; ctrl != ctrl_end && (*ctrl & 0x80) != 0; ++ctrl, ++slot);
+			}
+		};
+	public:
+		using iterator       = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+
+		flat_map() = default;
+		explicit flat_map(const allocator_type& alloc) : ctrl{ ctrl_allocator{ alloc } } {}
+		flat_map(const flat_map& o) : flat_map{ o, alloc_traits::select_on_container_copy_construction(o.get_allocator()) } {}
+		flat_map(const flat_map& o, const allocator_type& alloc) : flat_map{ alloc }
+		{
+			reserve(o.size());
+			for (const auto& [key, value] : o)
+			{
+				try_emplace(key, value);
+			}
+		}
+		flat_map(flat_map&& o) noexcept :
+			ctrl{ ::std::move(o.ctrl) },
+			slots{ ::std::exchange(o.slots, nullptr) },
+			slot_count{ ::std::exchange(o.slot_count, 0) },
+			entry_count{ ::std::exchange(o.entry_count, 0) },
+			growth_left{ ::std::exchange(o.growth_left, 0) }
+		{
+			o.ctrl.clear();
+		}
+		flat_map(flat_map&& o, const allocator_type& alloc) : flat_map{ alloc }
+		{
+			if (get_allocator() == o.get_allocator())
+			{
+				swap_members(o);
+			}
+			else
+			{
+				reserve(o.size());
+				for (auto& [key, value] : o)
+				{
+					try_emplace(key, ::std::move(value));
+				}
+				o.clear();
+			}
+		}
+		flat_map(::std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type{}) : flat_map{ alloc }
+		{
+			reserve(il.size());
+			for (const auto& v : il)
+			{
+				try_emplace(v.first, v.second);
+			}
+		}
+		// allocator of this map is kept as allocator aware containers do when it is not propagated,
+		// so entries are copied or moved into it
+		flat_map& operator=(const flat_map& o)
+		{
+			if (this != &o)
+			{
+				auto copy = flat_map{ o, get_allocator() };
+				swap_members(copy);
+			}
+			return *this;
+		}
+		flat_map& operator=(flat_map&& o)
+		{
+			if (this != &o)
+			{
+				auto moved = flat_map{ ::std::move(o), get_allocator() };
+				swap_members(moved);
+			}
+			return *this;
+		}
+		~flat_map()
+		{
+			destroy_slots();
+		}
+
+		auto get_allocator() const noexcept -> allocator_type
+		{
+			return allocator_type{ ctrl.get_allocator() };
+		}
+
+		auto begin()        noexcept { return iterator{ ctrl.data(), ctrl.data() + capacity(), slots }; }
+		auto end()          noexcept { return iterator{ ctrl.data() + capacity(), ctrl.data() + capacity(), slots + capacity() }; }
+		auto begin()  const noexcept { return const_iterator{ const_cast<flat_map&>(*this).begin() }; }
+		auto end()    const noexcept { return const_iterator{ const_cast<flat_map&>(*this).end() }; }
+		auto cbegin() const noexcept { return begin(); }
+		auto cend()   const noexcept { return end();   }
+
+		auto empty() const noexcept { return entry_count == 0; }
+		auto size()  const noexcept { return entry_count;       }
+
+		void clear() noexcept
+		{
+			if (capacity() == 0)
+			{
+				return;
+			}
+			for (size_type i{}; i < capacity(); ++i)
+			{
+				if (is_full(i))
+				{
+					destroy_slot(i);
+				}
+			}
+			::std::memset(ctrl.data(), group::empty, ctrl.size());
+			entry_count = 0;
+			growth_left = max_load_of(capacity());
+		}
+
+		void reserve(size_type count_to_hold)
+		{
+			if (count_to_hold > entry_count + growth_left)
+			{
+				rehash(capacity_of(count_to_hold));
+			}
+		}
+
+		iterator erase(iterator pos)
+		{
+			auto i = static_cast<size_type>(pos.slot - slots);
+			destroy_slot(i);
+			--entry_count;
+			// slot is left empty if its group has empty slot, as no probe passed the group to reach a key after it
+			auto group_begin = ctrl.data() + i / group::width * group::width;
+			if (group::match(group_begin, group::empty) != 0)
+			{
+				ctrl[i] = group::empty;
+				++growth_left;
+			}
+			else
+			{
+				ctrl[i] = group::deleted;
+			}
+			return ++pos;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return erase(iterator{ pos.ctrl, pos.ctrl_end, pos.slot });
+		}
+
+		template <typename k_t>
+		size_type erase(k_t&& k)
+		{
+			auto k_it = find(k);
+			if (k_it == end()) return 0;
+			return erase(k_it), 1;
+		}
+
+		template <typename k_t>
+		auto at(const k_t& k) const -> const mapped_type&
+		{
+			auto k_it = find(k);
+			if (k_it == end())
+			{
+				throw ::std::out_of_range{ "out of range" };
+			}
+			return k_it->second;
+		}
+
+		template <typename k_t>
+		auto at(const k_t& k) -> mapped_type&
+		{
+			auto k_it = find(k);
+			if (k_it == end())
+			{
+				throw ::std::out_of_range{ "out of range" };
+			}
+			return k_it->second;
+		}
+
+		template <typename k_t>
+		auto operator[](k_t&& k) -> mapped_type&
+		{
+			return try_emplace(::std::forward<k_t>(k)).first->second;
+		}
+
+		// inserts value made by args if k is not found, k is converted to key_type only when it is inserted
+		template <typename k_t, typename... args_t>
+		auto try_emplace(k_t&& k, args_t&&... args) -> ::std::pair<iterator, bool>
+		{
+			auto hash = hasher{}(k);
+			if (auto found = find_index(k, hash); found != npos)
+			{
+				return { iterator_at(found), false };
+			}
+			if (growth_left == 0)
+			{
+				// rehashing in place drops deleted slots if they take most of slots
+				rehash(entry_count < max_load_of(capacity()) / 2 ? capacity() : capacity_of(entry_count + 1));
+			}
+			auto i = find_free(hash);
+			auto alloc = slot_allocator{ get_allocator() };
+			slot_traits::construct(alloc, slots + i,
+			                       ::std::piecewise_construct,
+			                       ::std::forward_as_tuple(::std::forward<k_t>(k)),
+			                       ::std::forward_as_tuple(::std::forward<args_t>(args)...));
+			growth_left -= ctrl[i] == group::empty;
+			ctrl[i] = h2_of(hash);
+			++entry_count;
+			return { iterator_at(i), true };
+		}
+
+		auto insert(const value_type& v) -> ::std::pair<iterator, bool>
+		{
+			return try_emplace(v.first, v.second);
+		}
+
+		auto insert(value_type&& v) -> ::std::pair<iterator, bool>
+		{
+			return try_emplace(v.first, ::std::move(v.second));
+		}
+
+		template <typename k_t>
+		bool contains(const k_t& k) const
+		{
+			return find_index(k, hasher{}(k)) != npos;
+		}
+
+		template <typename k_t>
+		auto count(const k_t& k) const -> size_type
+		{
+			return contains(k);
+		}
+
+		template <typename k_t>
+		auto find(const k_t& k) const -> const_iterator
+		{
+			return const_cast<flat_map&>(*this).find(k);
+		}
+
+		template <typename k_t>
+		auto find(const k_t& k) -> iterator
+		{
+			auto found = find_index(k, hasher{}(k));
+			return found == npos ? end() : iterator_at(found);
+		}
+
+		friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+		{
+			if (lhs.size() != rhs.size())
+			{
+				return false;
+			}
+			for (const auto& [key, value] : lhs)
+			{
+				auto it = rhs.find(key);
+				if (it == rhs.end() || !(it->second == value))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	private:
+		ctrl_type   ctrl{};          // control bytes of slots, those after slots of table less than a group are empty
+		slot_type*  slots{};         // slots allocated by allocator, constructed if their control bytes are full
+		size_type   slot_count{};    // capacity, which is 0 or power of 2 not less than 4
+		size_type   entry_count{};   // count of entries
+		size_type   growth_left{};   // count of empty slots which can be taken before rehashing
+
+		auto capacity() const noexcept -> size_type
+		{
+			return slot_count;
+		}
+
+		// at most 7/8 of slots are taken, so probe always reaches group having empty slot,
+		// all slots of table less than a group can be taken as control bytes after them are empty
+		static auto max_load_of(size_type capacity) noexcept -> size_type
+		{
+			return capacity < group::width ? capacity : capacity - capacity / 8;
+		}
+
+		static auto capacity_of(size_type count_to_hold) noexcept -> size_type
+		{
+			auto capacity = size_type{ 4 };
+			while (max_load_of(capacity) < count_to_hold)
+			{
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		static auto h1_of(::std::size_t hash) noexcept -> size_type
+		{
+			return static_cast<size_type>(hash >> 7);
+		}
+
+		static auto h2_of(::std::size_t hash) noexcept -> ::std::uint8_t
+		{
+			return static_cast<::std::uint8_t>(hash & 0x7F);
+		}
+
+		bool is_full(size_type i) const noexcept
+		{
+			return (ctrl[i] & 0x80) == 0;
+		}
+
+		auto iterator_at(size_type i) noexcept -> iterator
+		{
+			return iterator{ ctrl.data() + i, ctrl.data() + capacity(), slots + i };
+		}
+
+		// groups are probed by triangular numbers, which reach every group as count of groups is power of 2
+		template <typename f_t>
+		auto probe(::std::size_t hash, f_t&& f) const -> size_type
+		{
+			auto mask = ::std::max(capacity() / group::width, size_type{ 1 }) - 1;
+			auto g = h1_of(hash) & mask;
+			for (size_type step{ 1 }; ; g = (g + step++) & mask)
+			{
+				if (auto i = f(g * group::width); i != npos)
+				{
+					return i;
+				}
+			}
+		}
+
+		// position of entry whose key is k, npos if it is not found
+		template <typename k_t>
+		auto find_index(const k_t& k, ::std::size_t hash) const -> size_type
+		{
+			if (entry_count == 0)
+			{
+				return npos;
+			}
+			auto h2 = h2_of(hash);
+			size_type result = npos;
+			probe(hash, [&](size_type first) -> size_type
+			{
+				auto bytes = ctrl.data() + first;
+				for (auto mask = group::match(bytes, h2); mask != 0; mask &= mask - 1)
+				{
+					auto i = first + static_cast<size_type>(::std::countr_zero(mask));
+					if (key_equal{}(slots[i].value.first, k))
+					{
+						return result = i;
+					}
+				}
+				// probe stops at group having empty slot, as key is put into first free slot on its probe
+				return group::match(bytes, group::empty) != 0 ? 0 : npos;
+			});
+			return result;
+		}
+
+		// first empty or deleted slot on probe of hash, capacity must not be 0
+		auto find_free(::std::size_t hash) const -> size_type
+		{
+			return probe(hash, [&](size_type first) -> size_type
+			{
+				auto mask = group::match_free(ctrl.data() + first);
+				if (capacity() < group::width)
+				{
+					mask &= (::std::uint32_t{ 1 } << capacity()) - 1;
+				}
+				return mask != 0 ? first + static_cast<size_type>(::std::countr_zero(mask)) : npos;
+			});
+		}
+
+		void rehash(size_type new_capacity)
+		{
+			static_assert(::std::is_nothrow_move_constructible_v<slot_type>,
+			              "[pdn] entries of flat_map must be nothrow move constructible, as rehashing moves them");
+			auto alloc = slot_allocator{ get_allocator() };
+			auto old_ctrl = ctrl_type(::std::max(new_capacity, group::width), group::empty, ctrl.get_allocator());
+			auto new_slots = slot_traits::allocate(alloc, new_capacity);
+			ctrl.swap(old_ctrl);
+			auto old_slots = ::std::exchange(slots, new_slots);
+			auto old_count = ::std::exchange(slot_count, new_capacity);
+			growth_left = max_load_of(new_capacity) - entry_count;
+			for (size_type i{}; i < old_count; ++i)
+			{
+				if ((old_ctrl[i] & 0x80) != 0)
+				{
+					continue;
+				}
+				auto& old = old_slots[i];
+				auto hash = hasher{}(old.value.first);
+				auto j = find_free(hash);
+				slot_traits::construct(alloc, slots + j, ::std::move(old));
+				slot_traits::destroy(alloc, &old);
+				ctrl[j] = h2_of(hash);
+			}
+			if (old_slots)
+			{
+				slot_traits::deallocate(alloc, old_slots, old_count);
+			}
+		}
+
+		void destroy_slot(size_type i) noexcept
+		{
+			auto alloc = slot_allocator{ get_allocator() };
+			slot_traits::destroy(alloc, slots + i);
+		}
+
+		void destroy_slots() noexcept
+		{
+			if (!slots)
+			{
+				return;
+			}
+			for (size_type i{}; i < capacity(); ++i)
+			{
+				if (is_full(i))
+				{
+					destroy_slot(i);
+				}
+			}
+			auto alloc = slot_allocator{ get_allocator() };
+			slot_traits::deallocate(alloc, slots, capacity());
+			slots = nullptr;
+		}
+
+		// allocators of this and o must be equal
+		void swap_members(flat_map& o) noexcept
+		{
+			ctrl.swap(o.ctrl);
+			::std::swap(slots, o.slots);
+			::std::swap(slot_count, o.slot_count);
+			::std::swap(entry_count, o.entry_count);
+			::std::swap(growth_left, o.growth_left);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,752 @@
+#ifndef PDN_Header_pdn_frozen_document
+#define PDN_Header_pdn_frozen_document
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "pdn_unicode_base.h"
+#include "pdn_type.h"
+#include "pdn_type_code.h"
+#include "pdn_packed_list.h"
+#include "pdn_proxy.h"
+#include "pdn_utf_code_convert.h"
+#include "pdn_entity_utility.h"
+#include "pdn_entity.h"
+
+namespace pdn
+{
+	// immutable copy of entity for documents made once and read many times, such as config.
+	// entities are held in one vector in breadth first order, so elements of list and members of object are contiguous,
+	// keys are held in one buffer and strings in one vector, lists and objects refer to them by position.
+	// object of more than small_object_size members is indexed by minimal perfect hash,
+	// so finding key hashes it once and compares one key, smaller object compares hashes of its members in order.
+	// list whose elements are all of same integral, floating point or boolean type is packed into array of that type,
+	// such as list of f64 made by type spec of its elements, it is viewed by as_span<T>() and its elements are held
+	// by refer by value, other lists hold entities as object does.
+	// document is not changed after it is made, so it is read by threads at the same time without locks.
+	// refer of document is invalidated if document moves.
+	template <unicode::concepts::code_unit char_t>
+	class frozen_document
+	{
+	public:
+		using char_type   = char_t;
+		using entity_type = entity<char_type>;
+		using size_type   = ::std::size_t;
+		using index_type  = ::std::size_t;
+		using key_type    = ::std::basic_string_view<char_type>;
+		using string      = type::string<char_type>;
+		static constexpr size_type small_object_size = 8;
+	private:
+		using position_type = ::std::uint32_t;
+		using accessor      = detail::as_accessor<char_type>;
+		static constexpr position_type no_table         = ::std::numeric_limits<position_type>::max();
+		static constexpr position_type max_displacement = 1u << 16;
+
+		struct string_ref
+		{
+			position_type index; // in strings
+		};
+		struct list_ref
+		{
+			position_type first; // in nodes
+			position_type count;
+		};
+		struct packed_ref
+		{
+			position_type first; // in packed array of type
+			position_type count;
+			::std::size_t index; // of type in node
+		};
+		struct object_ref
+		{
+			position_type first;   // of values in nodes
+			position_type count;
+			position_type members; // first in members
+			position_type table;   // first in tables, no_table if members are compared in order
+		};
+		// same order as entity_variant
+		using node = ::std::variant<
+			type::i32, type::i64, type::i8, type::i16,
+			type::u32, type::u64, type::u8, type::u16,
+			type::f32, type::f64,
+			type::boolean,
+			type::character<char_type>,
+			string_ref,
+			list_ref,
+			object_ref,
+			packed_ref>;
+		// types packed, same order as node
+		static constexpr ::std::size_t packed_type_count = 11;
+		using packed_arrays = ::std::tuple<
+			detail::packed_array<type::i32>, detail::packed_array<type::i64>, detail::packed_array<type::i8>, detail::packed_array<type::i16>,
+			detail::packed_array<type::u32>, detail::packed_array<type::u64>, detail::packed_array<type::u8>, detail::packed_array<type::u16>,
+			detail::packed_array<type::f32>, detail::packed_array<type::f64>,
+			detail::packed_array<type::boolean>>;
+		struct member
+		{
+			position_type key_first; // in keys
+			position_type key_size;
+			::std::size_t hash;
+		};
+	public:
+		// refer to entity of document
+		class refer
+		{
+		public:
+			auto code() const noexcept -> type_code
+			{
+				constexpr type_code codes[] = {
+					type_code::i32, type_code::i64, type_code::i8, type_code::i16,
+					type_code::u32, type_code::u64, type_code::u8, type_code::u16,
+					type_code::f32, type_code::f64,
+					type_code::boolean,
+					type_code::character,
+					type_code::string,
+					type_code::list,
+					type_code::object,
+					type_code::list,
+				};
+				auto v = value();
+				return v ? codes[v->index()] : type_code::unknown;
+			}
+
+			// count of elements of list or members of object, 0 for other types
+			auto size() const noexcept -> size_type
+			{
+				if (auto l = ref<list_ref>())
+				{
+					return l->count;
+				}
+				if (auto o = ref<object_ref>())
+				{
+					return o->count;
+				}
+				if (auto p = ref<packed_ref>())
+				{
+					return p->count;
+				}
+				return 0;
+			}
+
+			// element of list, or value of member of object in order of object frozen
+			auto at(index_type index) const noexcept -> refer
+			{
+				if (auto l = ref<list_ref>(); l && index < l->count)
+				{
+					return refer{ doc, &doc->nodes[l->first + index] };
+				}
+				if (auto o = ref<object_ref>(); o && index < o->count)
+				{
+					return refer{ doc, &doc->nodes[o->first + index] };
+				}
+				if (auto p = ref<packed_ref>(); p && index < p->count)
+				{
+					return refer{ doc, doc->element_of(*p, index) };
+				}
+				return refer{};
+			}
+			auto at(const key_type key) const noexcept -> refer
+			{
+				if (auto o = ref<object_ref>())
+				{
+					return doc->find(*o, key);
+				}
+				return refer{};
+			}
+
+			auto operator[](index_type index)   const noexcept -> refer { return at(index); }
+			auto operator[](const key_type key) const noexcept -> refer { return at(key); }
+
+			// key of member of object in order of object frozen, empty if out of range
+			auto key_at(index_type index) const noexcept -> key_type
+			{
+				if (auto o = ref<object_ref>(); o && index < o->count)
+				{
+					return doc->key_of(doc->members[o->members + index]);
+				}
+				return key_type{};
+			}
+
+			bool has_value() const noexcept { return value(); }
+			explicit operator bool() const noexcept { return has_value(); }
+
+			template <typename target_t>
+			[[nodiscard]] decltype(auto) as() const
+			{
+				using real_type = detail::tag_to_type_t<target_t, char_type>;
+				if constexpr (type::concepts::pdn_sint<real_type>)
+				{
+					return as_int(real_type{});
+				}
+				else if constexpr (type::concepts::pdn_uint<real_type>)
+				{
+					return as_uint(real_type{});
+				}
+				else if constexpr (type::concepts::pdn_fp<real_type>)
+				{
+					return as_fp(real_type{});
+				}
+				else if constexpr (::std::same_as<real_type, type::boolean>)
+				{
+					return as_bool();
+				}
+				else if constexpr (::std::same_as<real_type, type::character<char_type>>)
+				{
+					return as_char();
+				}
+				else if constexpr (::std::same_as<real_type, type::u8char>)
+				{
+					return as_u8char();
+				}
+				else if constexpr (::std::same_as<real_type, type::u16char>)
+				{
+					return as_u16char();
+				}
+				else if constexpr (::std::same_as<real_type, type::u32char>)
+				{
+					return as_u32char();
+				}
+				else if constexpr (::std::same_as<real_type, string>)
+				{
+					return as_string();
+				}
+				else if constexpr (::std::same_as<real_type, type::u8string>)
+				{
+					return as_u8string();
+				}
+				else if constexpr (::std::same_as<real_type, type::u16string>)
+				{
+					return as_u16string();
+				}
+				else if constexpr (::std::same_as<real_type, type::u32string>)
+				{
+					return as_u32string();
+				}
+				else
+				{
+					static_assert(false, "[pdn] unsupported type for as<T>(frozen_document::refer), list and object are accessed by at()");
+				}
+			}
+
+			template <detail::as_tparam tag_t>
+			[[nodiscard]] decltype(auto) as(tag_t) const
+			{
+				return as<tag_t>();
+			}
+
+			[[nodiscard]] auto as_int() const -> detail::as_int_default_t
+			{
+				return as_int(detail::as_int_default_t{});
+			}
+
+			template <detail::sint_or_tag in>
+			[[nodiscard]] auto as_int(in) const -> detail::as_rttype_t<in, char_type>
+			{
+				return visit([]<typename arg_t>(const arg_t& v)
+				{
+					return detail::as_int<arg_t, detail::tag_to_type_t<in, char_type>>(v);
+				});
+			}
+
+			[[nodiscard]] auto as_uint() const -> detail::as_uint_default_t
+			{
+				return as_uint(detail::as_uint_default_t{});
+			}
+
+			template <detail::uint_or_tag un>
+			[[nodiscard]] auto as_uint(un) const -> detail::as_rttype_t<un, char_type>
+			{
+				return visit([]<typename arg_t>(const arg_t& v)
+				{
+					return detail::as_uint<arg_t, detail::tag_to_type_t<un, char_type>>(v);
+				});
+			}
+
+			[[nodiscard]] auto as_fp() const -> detail::as_fp_default_t
+			{
+				return as_fp(detail::as_fp_default_t{});
+			}
+
+			template <detail::fp_or_tag fn>
+			[[nodiscard]] auto as_fp(fn) const -> detail::as_rttype_t<fn, char_type>
+			{
+				return visit([]<typename arg_t>(const arg_t& v)
+				{
+					return detail::as_fp<arg_t, detail::tag_to_type_t<fn, char_type>>(v);
+				});
+			}
+
+			[[nodiscard]] auto as_bool() const -> type::boolean
+			{
+				return visit([](const auto& v) { return accessor::as_bool(v); });
+			}
+
+			[[nodiscard]] auto as_char() const -> type::character<char_type>
+			{
+				auto p = get_if<type::character<char_type>>();
+				return p ? *p : type::character<char_type>{};
+			}
+
+			[[nodiscard]] auto as_u8char() const -> type::u8char
+			{
+				return convert_char<type::u8char, type::u8string>();
+			}
+
+			[[nodiscard]] auto as_u16char() const -> type::u16char
+			{
+				return convert_char<type::u16char, type::u16string>();
+			}
+
+			[[nodiscard]] auto as_u32char() const -> type::u32char
+			{
+				return convert_char<type::u32char, type::u32string>();
+			}
+
+			[[nodiscard]] auto as_string() const -> const string&
+			{
+				auto p = get_if<string>();
+				return p ? *p : accessor::null_string_val();
+			}
+
+			[[nodiscard]] auto as_u8string() const -> detail::as_rttype_t<type::u8string, char_type>
+			{
+				return convert_string<type::u8string>();
+			}
+
+			[[nodiscard]] auto as_u16string() const -> detail::as_rttype_t<type::u16string, char_type>
+			{
+				return convert_string<type::u16string>();
+			}
+
+			[[nodiscard]] auto as_u32string() const -> detail::as_rttype_t<type::u32string, char_type>
+			{
+				return convert_string<type::u32string>();
+			}
+
+			// get_opt is for basic type only, returns std::nullopt if type mismatch or no value
+			template <typename target_t>
+			[[nodiscard]] auto get_opt() const -> ::std::optional<target_t>
+			{
+				static_assert(type::concepts::basic_type<target_t, char_type>, "requires pdn basic type");
+				if (auto p = get_if<target_t>())
+				{
+					return ::std::make_optional<target_t>(*p);
+				}
+				return ::std::nullopt;
+			}
+
+			// get_if is for basic type and string only, nullptr if type mismatch or no value
+			template <typename target_t>
+			[[nodiscard]] auto get_if() const noexcept -> const target_t*
+			{
+				if constexpr (::std::same_as<target_t, string>)
+				{
+					auto s = ref<string_ref>();
+					return s ? &doc->strings[s->index] : nullptr;
+				}
+				else
+				{
+					static_assert(type::concepts::basic_type<target_t, char_type>, "[pdn] requires pdn basic type or string");
+					auto v = value();
+					return v ? ::std::get_if<target_t>(v) : nullptr;
+				}
+			}
+
+			// elements of packed list of target_t, empty if list is not packed or its type mismatch
+			template <typename target_t>
+			[[nodiscard]] auto as_span() const noexcept -> ::std::span<const target_t>
+			{
+				static_assert(index_of<target_t>() < packed_type_count, "[pdn] only lists of integral, floating point or boolean are packed");
+				if (auto p = ref<packed_ref>(); p && p->index == index_of<target_t>())
+				{
+					return { ::std::get<index_of<target_t>()>(doc->packed).data() + p->first, p->count };
+				}
+				return {};
+			}
+
+			// test if refer has a value of type target_t, list and object are tested by code()
+			template <typename target_t>
+			[[nodiscard]] bool type_test() const noexcept
+			{
+				return get_if<target_t>();
+			}
+
+			refer() = default;
+		private:
+			friend frozen_document;
+			refer(const frozen_document* d, const node* n) noexcept : doc{ d }, ptr{ n } {}
+			refer(const frozen_document* d, node e) noexcept : doc{ d }, element{ e } {}
+
+			// node of document, or element of packed list held by refer
+			auto value() const noexcept -> const node*
+			{
+				return ptr ? ptr : doc ? &element : nullptr;
+			}
+
+			template <typename ref_t>
+			auto ref() const noexcept -> const ref_t*
+			{
+				auto v = value();
+				return v ? ::std::get_if<ref_t>(v) : nullptr;
+			}
+
+			// calls f with value held, i32 of 0 if no value, references of list and object are passed as they are
+			template <typename f_t>
+			decltype(auto) visit(f_t&& f) const
+			{
+				auto v = value();
+				if (!v)
+				{
+					return ::std::forward<f_t>(f)(type::i32{});
+				}
+				return ::std::visit(::std::forward<f_t>(f), *v);
+			}
+
+			template <typename char_type_t, typename string_t>
+			auto convert_char() const -> char_type_t
+			{
+				if constexpr (::std::same_as<char_type_t, type::character<char_type>>)
+				{
+					return as_char();
+				}
+				else
+				{
+					auto converted = unicode::code_convert<string_t>(as_char().to_string_view());
+					return char_type_t{ converted.cbegin(), converted.size() };
+				}
+			}
+
+			template <typename string_t>
+			auto convert_string() const -> detail::as_rttype_t<string_t, char_type>
+			{
+				if constexpr (::std::same_as<string_t, string>)
+				{
+					return as_string();
+				}
+				else
+				{
+					return unicode::code_convert<string_t>(as_string());
+				}
+			}
+		private:
+			const frozen_document* doc{};
+			const node*            ptr{};     // nullptr if refer holds element of packed list
+			node                   element{}; // element of packed list
+		};
+	public:
+		auto root() const noexcept -> refer { return refer{ this, &nodes.front() }; }
+
+		auto at(const key_type key)         const noexcept -> refer { return root().at(key); }
+		auto operator[](const key_type key) const noexcept -> refer { return root().at(key); }
+
+		// count of entities, including root
+		auto size() const noexcept -> size_type
+		{
+			return nodes.size();
+		}
+
+		explicit frozen_document(const entity_type& e)
+		{
+			freeze(e);
+		}
+		frozen_document(const frozen_document&) = default;
+		frozen_document(frozen_document&&) = default;
+		frozen_document& operator=(const frozen_document&) = default;
+		frozen_document& operator=(frozen_document&&) = default;
+		~frozen_document() = default;
+	private:
+		::std::vector<node>          nodes{};
+		::std::vector<member>        members{}; // members of each object are contiguous, in same order as their values
+		::std::vector<position_type> tables{};  // displacements of buckets of object, then positions of members by slot
+		::std::vector<string>        strings{};
+		::std::basic_string<char_t>  keys{};
+		packed_arrays                packed{};
+
+		template <typename t>
+		static constexpr auto index_of() noexcept -> ::std::size_t
+		{
+			return node{ ::std::in_place_type<t> }.index();
+		}
+
+		auto element_of(const packed_ref& p, index_type index) const noexcept -> node
+		{
+			auto result = node{};
+			[&]<::std::size_t... i>(::std::index_sequence<i...>)
+			{
+				((p.index == i ? (void)result.template emplace<i>(::std::get<i>(packed).data()[p.first + index]) : void()), ...);
+			}(::std::make_index_sequence<packed_type_count>{});
+			return result;
+		}
+
+		// packs l into array of type of its elements if they are all of same type to be packed
+		auto pack(const type::list<char_type>& l) -> ::std::optional<packed_ref>
+		{
+			if (l.empty() || l.front().index() >= packed_type_count)
+			{
+				return ::std::nullopt;
+			}
+			auto index = l.front().index();
+			for (const auto& element : l)
+			{
+				if (element.index() != index)
+				{
+					return ::std::nullopt;
+				}
+			}
+			auto result = ::std::optional<packed_ref>{};
+			[&]<::std::size_t... i>(::std::index_sequence<i...>)
+			{
+				((index == i ? (void)(result = pack_as<i>(l)) : void()), ...);
+			}(::std::make_index_sequence<packed_type_count>{});
+			return result;
+		}
+
+		template <::std::size_t index>
+		auto pack_as(const type::list<char_type>& l) -> packed_ref
+		{
+			auto& array = ::std::get<index>(packed);
+			position_of(array.size() + l.size());
+			auto first = static_cast<position_type>(array.size());
+			array.reserve(array.size() + l.size());
+			for (const auto& element : l)
+			{
+				array.push_back(::std::get<index>(element));
+			}
+			return packed_ref{ first, static_cast<position_type>(l.size()), index };
+		}
+
+		// copies elements of packed list into array of their type
+		template <typename t>
+		auto pack_elements(::std::span<const t> elements) -> packed_ref
+		{
+			constexpr auto index = index_of<t>();
+			auto& array = ::std::get<index>(packed);
+			position_of(array.size() + elements.size());
+			auto first = static_cast<position_type>(array.size());
+			array.reserve(array.size() + elements.size());
+			for (auto v : elements)
+			{
+				array.push_back(v);
+			}
+			return packed_ref{ first, static_cast<position_type>(elements.size()), index };
+		}
+
+		auto key_of(const member& m) const noexcept -> key_type
+		{
+			return key_type{ keys.data() + m.key_first, m.key_size };
+		}
+
+		static auto hash_of(const key_type key) noexcept -> ::std::size_t
+		{
+			return type::config::key_hasher{}(key);
+		}
+
+		static auto bucket_count_of(position_type count) noexcept -> position_type
+		{
+			return (count + 3) / 4;
+		}
+
+		// maps x to [0, n) without division
+		static auto reduce(::std::uint64_t x, position_type n) noexcept -> position_type
+		{
+			return static_cast<position_type>(((x & 0xFFFF'FFFFu) * n) >> 32);
+		}
+
+		static auto bucket_of(::std::size_t hash, position_type buckets) noexcept -> position_type
+		{
+			return reduce(static_cast<::std::uint64_t>(hash), buckets);
+		}
+
+		static auto slot_of(::std::size_t hash, position_type displacement, position_type count) noexcept -> position_type
+		{
+			auto x = static_cast<::std::uint64_t>(hash) ^ (displacement * 0x9E37'79B9'7F4A'7C15u);
+			x ^= x >> 33;
+			x *= 0xFF51'AFD7'ED55'8CCDu;
+			x ^= x >> 33;
+			return reduce(x >> 16, count);
+		}
+
+		auto find(const object_ref& o, const key_type key) const noexcept -> refer
+		{
+			auto hash = hash_of(key);
+			if (o.table == no_table)
+			{
+				for (position_type i{}; i < o.count; ++i)
+				{
+					const auto& m = members[o.members + i];
+					if (m.hash == hash && key_of(m) == key)
+					{
+						return refer{ this, &nodes[o.first + i] };
+					}
+				}
+				return refer{};
+			}
+			auto buckets      = bucket_count_of(o.count);
+			auto displacement = tables[o.table + bucket_of(hash, buckets)];
+			auto i            = tables[o.table + buckets + slot_of(hash, displacement, o.count)];
+			const auto& m     = members[o.members + i];
+			return m.hash == hash && key_of(m) == key ? refer{ this, &nodes[o.first + i] } : refer{};
+		}
+
+		// checks n is held by position_type
+		static auto position_of(size_type n) -> position_type
+		{
+			if (n >= no_table)
+			{
+				throw ::std::length_error{ "[pdn] frozen_document is too large" };
+			}
+			return static_cast<position_type>(n);
+		}
+
+		// entities are put in nodes in breadth first order, sources[i] is entity of nodes[i]
+		void freeze(const entity_type& e)
+		{
+			auto sources = ::std::vector<const entity_type*>{ &e };
+			nodes.emplace_back();
+			for (size_type i{}; i < sources.size(); ++i)
+			{
+				nodes[i] = ::std::visit([&]<typename arg_t>(const arg_t& v) -> node
+				{
+					if constexpr (::std::same_as<arg_t, proxy<type::string<char_type>>>)
+					{
+						strings.push_back(*v);
+						return string_ref{ position_of(strings.size() - 1) };
+					}
+					else if constexpr (::std::same_as<arg_t, proxy<type::list<char_type>>>)
+					{
+						if (auto p = pack(*v))
+						{
+							return *p;
+						}
+						position_of(nodes.size() + v->size());
+						auto first = static_cast<position_type>(nodes.size());
+						for (const auto& element : *v)
+						{
+							sources.push_back(&element);
+						}
+						nodes.resize(nodes.size() + v->size());
+						return list_ref{ first, static_cast<position_type>(v->size()) };
+					}
+					else if constexpr (::std::same_as<arg_t, proxy<type::packed_list>>)
+					{
+						return v->visit([&](auto elements) -> node { return pack_elements(elements); });
+					}
+					else if constexpr (::std::same_as<arg_t, proxy<type::object<char_type>>>)
+					{
+						position_of(nodes.size() + v->size());
+						position_of(members.size() + v->size());
+						auto o = object_ref{};
+						o.first   = static_cast<position_type>(nodes.size());
+						o.count   = static_cast<position_type>(v->size());
+						o.members = static_cast<position_type>(members.size());
+						for (const auto& [iden, value] : *v)
+						{
+							auto key = key_type{ iden };
+							position_of(keys.size() + key.size());
+							members.push_back(member{ static_cast<position_type>(keys.size()), static_cast<position_type>(key.size()), hash_of(key) });
+							keys.append(key);
+							sources.push_back(&value);
+						}
+						nodes.resize(nodes.size() + v->size());
+						o.table = o.count > small_object_size ? make_table(o) : no_table;
+						return o;
+					}
+					else
+					{
+						return v;
+					}
+				}, *sources[i]);
+			}
+		}
+
+		// hash and displace: members are put in buckets by hash, then buckets of more members first find
+		// displacement which puts all their members in free slots, no_table if no displacement is found
+		auto make_table(const object_ref& o) -> position_type
+		{
+			auto buckets = bucket_count_of(o.count);
+			auto by_bucket = ::std::vector<::std::vector<position_type>>(buckets);
+			for (position_type i{}; i < o.count; ++i)
+			{
+				by_bucket[bucket_of(members[o.members + i].hash, buckets)].push_back(i);
+			}
+			auto order = ::std::vector<position_type>(buckets);
+			for (position_type b{}; b < buckets; ++b)
+			{
+				order[b] = b;
+			}
+			::std::stable_sort(order.begin(), order.end(), [&](position_type l, position_type r)
+			{
+				return by_bucket[l].size() > by_bucket[r].size();
+			});
+
+			position_of(tables.size() + buckets + o.count);
+			auto table = static_cast<position_type>(tables.size());
+			tables.resize(tables.size() + buckets + o.count, no_table);
+			auto displacements = tables.begin() + table;
+			auto slots         = displacements + buckets;
+			auto taken         = ::std::vector<position_type>{};
+			for (auto b : order)
+			{
+				const auto& in_bucket = by_bucket[b];
+				auto found = false;
+				for (position_type d{}; !found && d < max_displacement; ++d)
+				{
+					taken.clear();
+					found = true;
+					for (auto i : in_bucket)
+					{
+						auto s = slot_of(members[o.members + i].hash, d, o.count);
+						if (slots[s] != no_table || ::std::find(taken.begin(), taken.end(), s) != taken.end())
+						{
+							found = false;
+							break;
+						}
+						taken.push_back(s);
+					}
+					if (found)
+					{
+						displacements[b] = d;
+						for (size_type k{}; k < in_bucket.size(); ++k)
+						{
+							slots[taken[k]] = in_bucket[k];
+						}
+					}
+				}
+				if (!found)
+				{
+					// members of same hash, they are compared in order
+					tables.resize(table);
+					return no_table;
+				}
+			}
+			return table;
+		}
+	};
+
+	// makes frozen copy of e, e is not changed
+	template <typename char_t>
+	[[nodiscard]] auto freeze(const entity<char_t>& e) -> frozen_document<char_t>
+	{
+		return frozen_document<char_t>{ e };
+	}
+
+	using u8frozen_document  = frozen_document<char8_t>;
+	using u16frozen_document = frozen_document<char16_t>;
+	using u32frozen_document = frozen_document<char32_t>;
+}
+
+#endif
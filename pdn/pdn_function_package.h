@@ -2,12 +2,14 @@
 #define PDN_Header_pdn_function_package
 
 #include <iosfwd>
+#include <cstddef>
 
 #include "pdn_source_position_recorder.h"
 #include "pdn_error_handler.h"
 #include "pdn_error_message_generator.h"
 #include "pdn_constant_generator.h"
 #include "pdn_type_generator.h"
+#include "pdn_parser_utility.h"
 
 namespace pdn
 {
@@ -32,6 +34,14 @@ namespace pdn
 		{
 			return err_handler.limit;
 		}
+		void reset_max_nesting_depth(const ::std::size_t max_depth) noexcept
+		{
+			nesting_depth_limit = max_depth;
+		}
+		auto max_nesting_depth() const noexcept -> ::std::size_t
+		{
+			return nesting_depth_limit;
+		}
 		auto position() const -> pdn::source_position
 		{
 			return pos_recorder.position();
@@ -65,6 +75,7 @@ namespace pdn
 	private:
 		source_position_recorder        pos_recorder{};
 		default_threshold_error_handler err_handler{};
+		::std::size_t                   nesting_depth_limit{ parser_utility::default_max_nesting_depth };
 	};
 }
 
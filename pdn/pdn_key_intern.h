@@ -0,0 +1,285 @@
+#ifndef PDN_Header_pdn_key_intern
+#define PDN_Header_pdn_key_intern
+
+#include <cstddef>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <utility>
+
+#include "pdn_flat_map.h"
+
+namespace pdn::type::detail
+{
+	// storage of interned key, shared by keys holding it
+	template <typename char_t>
+	struct key_node
+	{
+		::std::atomic<::std::size_t> refs;
+		::std::size_t                hash; // ::std::hash of text as string_view, same as type::config::key_hasher
+		::std::basic_string<char_t>  text;
+	};
+
+	template <typename char_t>
+	auto hash_of_key(::std::basic_string_view<char_t> text) noexcept -> ::std::size_t
+	{
+		return ::std::hash<::std::basic_string_view<char_t>>{}(text);
+	}
+
+	template <typename char_t>
+	auto make_key_node(::std::size_t hash, ::std::basic_string<char_t> text) -> key_node<char_t>*
+	{
+		return new key_node<char_t>{ 1, hash, ::std::move(text) };
+	}
+
+	template <typename char_t>
+	void acquire_key_node(key_node<char_t>* node) noexcept
+	{
+		node->refs.fetch_add(1, ::std::memory_order_relaxed);
+	}
+
+	template <typename char_t>
+	void release_key_node(key_node<char_t>* node) noexcept
+	{
+		if (node->refs.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+		{
+			delete node;
+		}
+	}
+}
+
+namespace pdn
+{
+	template <typename char_t>
+	class key_table;
+
+	namespace detail
+	{
+		template <typename char_t>
+		inline auto current_key_table_ref() noexcept -> key_table<char_t>*&
+		{
+			thread_local key_table<char_t>* table = nullptr;
+			return table;
+		}
+	}
+
+	// key table of calling thread, nullptr out of any key_table_scope
+	template <typename char_t>
+	inline auto current_key_table() noexcept -> key_table<char_t>*
+	{
+		return detail::current_key_table_ref<char_t>();
+	}
+}
+
+namespace pdn::type
+{
+	// key of object sharing its immutable text with keys of same text made from same key_table,
+	// so documents of records repeating their keys hold each key once.
+	// keys made in key_table_scope are interned in its table, others hold their own text.
+	// hash of text is computed once, keys of same table are equal if they hold same text.
+	template <typename char_t>
+	class interned_key
+	{
+	public:
+		using char_type   = char_t;
+		using string_type = ::std::basic_string<char_t>;
+		using view_type   = ::std::basic_string_view<char_t>;
+
+		interned_key() noexcept = default;
+		interned_key(view_type text)           : interned_key{ adopt_tag{}, make_node(text) } {}
+		interned_key(const char_type* text)    : interned_key{ view_type{ text } } {}
+		interned_key(const string_type& text)  : interned_key{ view_type{ text } } {}
+		interned_key(string_type&& text)       : interned_key{ adopt_tag{}, make_node(::std::move(text)) } {}
+		interned_key(const interned_key& o) noexcept : node{ o.node }
+		{
+			if (node)
+			{
+				detail::acquire_key_node(node);
+			}
+		}
+		interned_key(interned_key&& o) noexcept : node{ ::std::exchange(o.node, nullptr) } {}
+		interned_key& operator=(const interned_key& o) noexcept
+		{
+			auto copy = interned_key{ o };
+			::std::swap(node, copy.node);
+			return *this;
+		}
+		interned_key& operator=(interned_key&& o) noexcept
+		{
+			::std::swap(node, o.node);
+			return *this;
+		}
+		~interned_key()
+		{
+			if (node)
+			{
+				detail::release_key_node(node);
+			}
+		}
+
+		auto str() const noexcept -> const string_type&
+		{
+			static const string_type empty_text{};
+			return node ? node->text : empty_text;
+		}
+		auto view() const noexcept -> view_type
+		{
+			return str();
+		}
+		auto hash() const noexcept -> ::std::size_t
+		{
+			return node ? node->hash : detail::hash_of_key(view_type{});
+		}
+
+		auto data()  const noexcept { return str().data();  }
+		auto c_str() const noexcept { return str().c_str(); }
+		auto size()  const noexcept { return str().size();  }
+		auto empty() const noexcept { return str().empty(); }
+		auto begin() const noexcept { return str().begin(); }
+		auto end()   const noexcept { return str().end();   }
+
+		operator const string_type&() const noexcept
+		{
+			return str();
+		}
+		operator view_type() const noexcept
+		{
+			return str();
+		}
+
+		// keys of same text interned by same table hold same node
+		friend bool operator==(const interned_key& lhs, const interned_key& rhs) noexcept
+		{
+			return lhs.node == rhs.node || (lhs.hash() == rhs.hash() && lhs.str() == rhs.str());
+		}
+		friend bool operator==(const interned_key& lhs, view_type rhs) noexcept
+		{
+			return lhs.str() == rhs;
+		}
+		friend bool operator==(const interned_key& lhs, const string_type& rhs) noexcept
+		{
+			return lhs.str() == rhs;
+		}
+		friend bool operator==(const interned_key& lhs, const char_type* rhs) noexcept
+		{
+			return lhs.str() == rhs;
+		}
+	private:
+		friend class key_table<char_t>;
+		struct adopt_tag {};
+		detail::key_node<char_t>* node{}; // nullptr for empty key made by default or moved from
+
+		interned_key(adopt_tag, detail::key_node<char_t>* adopted) noexcept : node{ adopted } {}
+
+		template <typename text_t>
+		static auto make_node(text_t&& text) -> detail::key_node<char_t>*;
+	};
+}
+
+namespace pdn
+{
+	// table sharing text of keys made in its key_table_scope, such as keys of documents parsed in the scope.
+	// text is kept by table until it is cleared or destroyed, and by keys holding it after that.
+	// table is not thread safe, it is used by thread of its scope only.
+	template <typename char_t>
+	class key_table
+	{
+	public:
+		using key_type  = type::interned_key<char_t>;
+		using view_type = ::std::basic_string_view<char_t>;
+
+		key_table() = default;
+		key_table(const key_table&) = delete;
+		key_table& operator=(const key_table&) = delete;
+		~key_table()
+		{
+			clear();
+		}
+
+		auto intern(view_type text) -> key_type
+		{
+			return key_type{ typename key_type::adopt_tag{}, acquire(text) };
+		}
+
+		// count of distinct keys
+		auto size() const noexcept -> ::std::size_t
+		{
+			return nodes.size();
+		}
+
+		// keys made before stay valid, they are not shared with keys made after
+		void clear() noexcept
+		{
+			for (auto& [text, node] : nodes)
+			{
+				type::detail::release_key_node(node);
+			}
+			nodes.clear();
+		}
+	private:
+		friend class type::interned_key<char_t>;
+		using node_type = type::detail::key_node<char_t>;
+		type::detail::flat_map<view_type, node_type*> nodes{}; // viewing text of nodes
+
+		// node of text whose reference is added for caller
+		template <typename text_t>
+		auto acquire(text_t&& text) -> node_type*
+		{
+			auto view = view_type{ text };
+			if (auto it = nodes.find(view); it != nodes.end())
+			{
+				type::detail::acquire_key_node(it->second);
+				return it->second;
+			}
+			auto hash = type::detail::hash_of_key(view); // before text is moved
+			auto node = type::detail::make_key_node<char_t>(hash, ::std::basic_string<char_t>{ ::std::forward<text_t>(text) });
+			try
+			{
+				nodes.try_emplace(view_type{ node->text }, node);
+			}
+			catch (...)
+			{
+				delete node;
+				throw;
+			}
+			type::detail::acquire_key_node(node);
+			return node;
+		}
+	};
+
+	// makes table current key table of calling thread for char_t in its lifetime,
+	// interned keys made by the thread in the scope share their text by the table.
+	template <typename char_t>
+	class key_table_scope
+	{
+	public:
+		explicit key_table_scope(key_table<char_t>& table) noexcept :
+			last{ ::std::exchange(detail::current_key_table_ref<char_t>(), &table) } {}
+		key_table_scope(const key_table_scope&) = delete;
+		key_table_scope& operator=(const key_table_scope&) = delete;
+		~key_table_scope()
+		{
+			detail::current_key_table_ref<char_t>() = last;
+		}
+	private:
+		key_table<char_t>* last{};
+	};
+}
+
+namespace pdn::type
+{
+	template <typename char_t>
+	template <typename text_t>
+	auto interned_key<char_t>::make_node(text_t&& text) -> detail::key_node<char_t>*
+	{
+		if (auto table = current_key_table<char_t>())
+		{
+			return table->acquire(::std::forward<text_t>(text));
+		}
+		auto hash = detail::hash_of_key(view_type{ text }); // before text is moved
+		return detail::make_key_node<char_t>(hash, string_type{ ::std::forward<text_t>(text) });
+	}
+}
+
+#endif
@@ -0,0 +1,321 @@
+#ifndef PDN_Header_pdn_lazy_document
+#define PDN_Header_pdn_lazy_document
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <concepts>
+#include <type_traits>
+#include <variant>
+
+#include "pdn_unicode_base.h"
+#include "pdn_source_position.h"
+#include "pdn_source_position_recorder.h"
+#include "pdn_source_locator.h"
+#include "pdn_error_message.h"
+#include "pdn_raw_error_message.h"
+#include "pdn_error_string.h"
+#include "pdn_lexical_error_code.h"
+#include "pdn_code_point_iterator.h"
+#include "pdn_lexer.h"
+#include "pdn_parser.h"
+#include "pdn_parser_utility.h"
+#include "pdn_function_package.h"
+#include "pdn_entity.h"
+
+namespace pdn::detail
+{
+	// function package of code point iterator and lexer for lazy_document,
+	// position is counted from where parsing starts, errors go to function package of parser.
+	// decode errors in body of list or object are dropped, they were reported when the body was skipped,
+	// so are lexical errors of the first token in body, which was read ahead before skipping.
+	template <typename function_package>
+	class lazy_source_package
+	{
+	public:
+		auto position() const -> source_position
+		{
+			return pos_recorder.position();
+		}
+		void update(const char32_t c)
+		{
+			pos_recorder.update(c);
+		}
+		void handle_error(const error_message& msg)
+		{
+			if (is_body && (is_muted || !::std::holds_alternative<lexical_error_code>(msg.error_code)))
+			{
+				return;
+			}
+			func_pkg->handle_error(msg);
+		}
+		auto generate_error_message(raw_error_message raw) -> error_msg_string
+		{
+			return func_pkg->generate_error_message(::std::move(raw));
+		}
+		void mute_lexical_errors(bool muted) noexcept
+		{
+			is_muted = muted;
+		}
+		lazy_source_package(function_package& function_pkg, source_position start, bool in_body) :
+			func_pkg    { &function_pkg },
+			pos_recorder{ start },
+			is_body     { in_body } {}
+	private:
+		function_package*        func_pkg{};
+		source_position_recorder pos_recorder{};
+		bool                     is_body{};
+		bool                     is_muted{};
+	};
+}
+
+namespace pdn
+{
+	// document whose lists and objects are parsed on first access.
+	// parsing of document makes top level entities only, bodies of lists and objects are skipped by lexer
+	// and parsed when they are touched by refer, so source must outlive the document (such as memory mapped file).
+	// notes:
+	//     errors in body of list or object are reported when it is parsed, unparsed bodies are never checked;
+	//     entity reached by pointer or reference of entity shows unparsed list or object as empty,
+	//     use refer of lazy_document to walk, or load_all() to parse everything;
+	//     copy of unparsed list or object stays empty;
+	//     decode errors are reported when document is parsed, as whole source is decoded then.
+	template <unicode::concepts::code_unit                  char_t,
+	          unicode::concepts::code_unit                  unit_t,
+	          concepts::function_package_for_parser<char_t> function_package = default_function_package<char_t>>
+	class lazy_document
+	{
+		// unparsed lists and objects are found by addresses held by proxies, which are kept when entities move
+		static_assert(::std::is_nothrow_move_constructible_v<entity<char_t>>, "[pdn] entity should be moved but not copied");
+	public:
+		using char_type   = char_t;
+		using unit_type   = unit_t;
+		using entity_type = entity<char_type>;
+		using source_type = ::std::basic_string_view<unit_type>;
+		using size_type   = ::std::size_t;
+		using index_type  = ::std::size_t;
+		using key_type    = ::std::basic_string_view<char_type>;
+	private:
+		using lazy_container = parser_utility::lazy_container;
+		using source_pkg     = detail::lazy_source_package<function_package>;
+		// code units of unparsed list or object, from left bracket to right bracket (or end of source)
+		struct source_range
+		{
+			size_type       first{};
+			size_type       last{};
+			source_position position{}; // position of left bracket
+			size_type       depth{};    // nesting depth
+		};
+	public:
+		// refer to entity of document, list or object is parsed when it is accessed by refer
+		class refer
+		{
+		public:
+			auto at(index_type index)   const -> refer { return expand() ? refer{ doc, ptr->at(index).get() } : refer{}; }
+			auto at(const key_type key) const -> refer { return expand() ? refer{ doc, ptr->at(key).get() }   : refer{}; }
+
+			auto operator[](index_type index)   const -> refer { return at(index); }
+			auto operator[](const key_type key) const -> refer { return at(key); }
+
+			bool has_value() const noexcept { return ptr; }
+			// get() returns pointer to entity whose list or object is parsed, but its elements may be not
+			entity_type* get() const { return expand(); }
+			entity_type* operator->() const { return get(); }
+			entity_type& operator*() const { return *get(); }
+			explicit operator bool() const noexcept { return has_value(); }
+			// parses all lists and objects in entity
+			auto load_all() const -> pdn::refer<char_type>
+			{
+				if (!ptr)
+				{
+					return pdn::refer<char_type>{};
+				}
+				doc->expand_all(*ptr);
+				return pdn::refer<char_type>{ *ptr };
+			}
+
+			refer() = default;
+		private:
+			friend lazy_document;
+			refer(lazy_document* d, entity_type* e) : doc{ e ? d : nullptr }, ptr{ e } {}
+			entity_type* expand() const
+			{
+				if (ptr)
+				{
+					doc->expand(*ptr);
+				}
+				return ptr;
+			}
+		private:
+			lazy_document* doc{};
+			entity_type*   ptr{};
+		};
+	public:
+		auto root() -> refer { return refer{ this, &root_entity }; }
+
+		auto at(const key_type key)         -> refer { return root().at(key); }
+		auto operator[](const key_type key) -> refer { return root().at(key); }
+
+		// parses all lists and objects left, returns whole document
+		auto load_all() -> entity_type&
+		{
+			expand_all(root_entity);
+			return root_entity;
+		}
+		// count of lists and objects left unparsed which are reachable
+		auto pending_count() const noexcept -> size_type
+		{
+			return pending.size();
+		}
+		auto source() const noexcept -> source_type
+		{
+			return source_view;
+		}
+
+		// refer of document is invalidated if document moves
+		lazy_document(lazy_document&&) = default;
+		lazy_document& operator=(lazy_document&&) = default;
+
+		lazy_document(source_type src, function_package& function_pkg) :
+			source_view{ src },
+			func_pkg   { &function_pkg },
+			par        { function_pkg }
+		{
+			parse_document();
+		}
+		explicit lazy_document(source_type src) requires ::std::default_initializable<function_package> :
+			source_view{ src },
+			owned_pkg  { ::std::make_unique<function_package>() },
+			func_pkg   { owned_pkg.get() },
+			par        { *owned_pkg }
+		{
+			parse_document();
+		}
+	private:
+		void parse_document()
+		{
+			auto o = type::object<char_t>{};
+			found.clear();
+			parse_range(source_range{ .first = 0, .last = source_view.size(), .position = {} }, false, [&](auto begin, auto end, source_pkg&)
+			{
+				par.parse_lazy(::std::move(begin), ::std::move(end), o, found);
+			});
+			root_entity = make_proxy<type::object<char_t>>(::std::move(o));
+			record_found(0, source_position{});
+		}
+
+		// parses body of list or object held by e if it is left unparsed
+		void expand(entity_type& e)
+		{
+			if (pending.empty())
+			{
+				return;
+			}
+			auto it = pending.find(parser_utility::container_address(e));
+			if (it == pending.end())
+			{
+				return;
+			}
+			const auto range = it->second;
+			pending.erase(it);
+			found.clear();
+			parse_range(range, true, [&](auto begin, auto end, source_pkg& src_fp)
+			{
+				// to [ CURPOS ...
+				auto opening = *begin;
+				src_fp.mute_lexical_errors(true);
+				++begin;
+				src_fp.mute_lexical_errors(false);
+				par.parse_lazy_container(::std::move(opening), ::std::move(begin), ::std::move(end), e, range.depth, found);
+			});
+			record_found(range.first, range.position);
+		}
+
+		void expand_all(entity_type& e)
+		{
+			auto stack = ::std::vector<entity_type*>{ &e };
+			while (!stack.empty() && !pending.empty())
+			{
+				auto& top = *stack.back();
+				stack.pop_back();
+				expand(top);
+				if (auto l = ::std::get_if<proxy<type::list<char_t>>>(&top))
+				{
+					for (auto& element : **l)
+					{
+						stack.push_back(&element);
+					}
+				}
+				else if (auto o = ::std::get_if<proxy<type::object<char_t>>>(&top))
+				{
+					for (auto& [key, value] : **o)
+					{
+						stack.push_back(&value);
+					}
+				}
+			}
+		}
+
+		void parse_range(const source_range& range, bool is_body, auto&& parse_tokens)
+		{
+			auto src_fp    = source_pkg{ *func_pkg, range.position, is_body };
+			auto first     = source_view.data() + range.first;
+			auto last      = source_view.data() + range.last;
+			lexer<char_t, source_pkg> lex{ src_fp };
+			auto cp_it     = make_code_point_iterator(first, last, src_fp);
+			auto token_it  = make_token_iterator(lex, cp_it, last);
+			auto token_end = make_end_token_iterator(token_it);
+			parse_tokens(::std::move(token_it), ::std::move(token_end), src_fp);
+		}
+
+		// locates brackets of containers found by last parse in source, which starts from offset at start
+		void record_found(size_type offset, source_position start)
+		{
+			auto locator = detail::source_locator<unit_t>{ source_view, offset, start };
+			for (const auto& current : found)
+			{
+				const auto first = locator.find(current.open_pos);
+				const auto last  = current.close_pos ? locator.find(*current.close_pos) : ::std::nullopt;
+				assert(first && (last || !current.close_pos) && "[pdn] brackets of lazy container not located");
+				if (!first)
+				{
+					continue; // left empty
+				}
+				pending.emplace(current.address, source_range{
+					.first    = *first,
+					.last     = last ? *last + 1 : source_view.size(),
+					.position = current.open_pos,
+					.depth    = current.depth
+				});
+			}
+		}
+	private:
+		source_type                                     source_view{};
+		::std::unique_ptr<function_package>             owned_pkg{};   // made by lazy_document if not given
+		function_package*                               func_pkg{};
+		parser<char_t, function_package>                par;
+		entity_type                                     root_entity{};
+		::std::unordered_map<const void*, source_range> pending{};     // unparsed lists and objects by their addresses
+		::std::vector<lazy_container>                   found{};       // unparsed lists and objects recorded by last parse
+	};
+
+	template <unicode::concepts::code_unit                  char_t,
+	          unicode::concepts::code_unit                  unit_t,
+	          concepts::function_package_for_parser<char_t> fn_pkg>
+	[[nodiscard]] auto make_lazy_document(::std::basic_string_view<unit_t> source, fn_pkg& fp, char_t = {}) -> lazy_document<char_t, unit_t, fn_pkg>
+	{
+		return lazy_document<char_t, unit_t, fn_pkg>{ source, fp };
+	}
+	template <unicode::concepts::code_unit char_t,
+	          unicode::concepts::code_unit unit_t>
+	[[nodiscard]] auto make_lazy_document(::std::basic_string_view<unit_t> source, char_t = {}) -> lazy_document<char_t, unit_t>
+	{
+		return lazy_document<char_t, unit_t>{ source };
+	}
+}
+
+#endif
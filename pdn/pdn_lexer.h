@@ -2,6 +2,7 @@
 #define PDN_Header_pdn_lexer
 
 #include <cassert>
+#include <cfloat>
 #include <cstdint>
 #include <string>
 #include <memory>
@@ -12,15 +13,20 @@
 #include <concepts>
 #include <algorithm>
 #include <type_traits>
+#include <span>
+#include <vector>
 
 #include "pdn_dfa_state_code.h"
 #include "pdn_dfa_state_object.h"
 #include "pdn_dfa_state_objects.h"
+#include "pdn_dfa_transition_table.h"
 
 #include "pdn_source_position_recorder_concept.h"
 #include "pdn_error_handler_concept.h"
 #include "pdn_error_message_generator_concept.h"
 
+#include "pdn_code_point_iterator.h"
+#include "pdn_unicode_simd.h"
 #include "pdn_utf_code_convert.h"
 #include "pdn_lexical_error_code.h"
 
@@ -35,7 +41,8 @@ namespace pdn::concepts
 
 namespace pdn
 {
-	template <unicode::concepts::code_unit char_t, concepts::function_package_for_lexer function_package>
+	// dfa_engine_t transforms dfa states, dfa_transition_table by default, dfa_transformer_engine is its reference
+	template <unicode::concepts::code_unit char_t, concepts::function_package_for_lexer function_package, typename dfa_engine_t = dfa_transition_table>
 	class lexer;
 }
 
@@ -46,13 +53,18 @@ namespace pdn::detail
 	{
 		using lexer_t = lexer<char_t, function_package>;
 		using token_t = token<char_t>;
-		lexer_t    lex;
-		it_begin_t begin;
-		it_end_t   end;
+		lexer_t             lex;
+		it_begin_t          begin;
+		it_end_t            end;
+		::std::vector<bool> opened_objects{}; // for skip_container, true for object and false for list
 		token_t get_token()
 		{
 			return lex.get_token(begin, end); // if begin == end then return eof
 		}
+		token_t skip_token()
+		{
+			return lex.skip_token(begin, end);
+		}
 	};
 }
 
@@ -79,6 +91,46 @@ namespace pdn
 		{
 			to_next_impl();
 		}
+		// skips rest of list or object opened by opening bracket, tokens are lexed by skipping mode of lexer.
+		// current token is the first one of rest, then it becomes right bracket closing the list or object,
+		// or iterator reaches end. right bracket of the other kind is skipped, as parser ignores it.
+		void skip_container(pdn_token_code opening)
+		{
+			using enum pdn_token_code;
+			if (!ctrl_opt.has_value())
+			{
+				return;
+			}
+			auto& opened = ctrl_opt->opened_objects;
+			opened.assign(1, opening == left_curly_brackets);
+			for (;;)
+			{
+				switch (stored_token.code)
+				{
+				case left_brackets:
+				case left_curly_brackets:
+					opened.push_back(stored_token.code == left_curly_brackets);
+					break;
+				case right_brackets:
+				case right_curly_brackets:
+					if (opened.back() == (stored_token.code == right_curly_brackets))
+					{
+						opened.pop_back();
+						if (opened.empty())
+						{
+							return;
+						}
+					}
+					break;
+				case eof:
+					ctrl_opt = ::std::nullopt;
+					return;
+				default:
+					break;
+				}
+				stored_token = ctrl_opt->skip_token();
+			}
+		}
 		const value_type& operator*() const noexcept
 		{
 			return stored_token;
@@ -201,6 +253,165 @@ namespace pdn::detail
 		::std::erase(num_str, '\'');
 	}
 
+	// 0 ~ 15 for digit of base 16 or less, 16 for other characters
+	constexpr auto digit_value(char c) noexcept -> unsigned
+	{
+		if (c >= '0' && c <= '9')
+		{
+			return static_cast<unsigned>(c - '0');
+		}
+		if (c >= 'a' && c <= 'f')
+		{
+			return static_cast<unsigned>(c - 'a' + 10);
+		}
+		if (c >= 'A' && c <= 'F')
+		{
+			return static_cast<unsigned>(c - 'A' + 10);
+		}
+		return 16;
+	}
+
+	// value of number sequence (without prefix) in base 2, 8, 10 or 16, separators are skipped.
+	// only sequence which can not overflow is accepted,
+	// returns nullopt for others and caller falls back to from_chars (which reports errors).
+	inline auto scan_unsigned_integer(::std::string_view seq, unsigned base) noexcept -> ::std::optional<type::u64>
+	{
+		const ::std::size_t max_digits = base == 2 ? 64 : base == 8 ? 21 : base == 10 ? 19 : 16;
+		type::u64     value{};
+		::std::size_t digits{};
+		for (auto c : seq)
+		{
+			if (c == '\'')
+			{
+				continue;
+			}
+			const auto digit = digit_value(c);
+			if (digit >= base || ++digits > max_digits)
+			{
+				return ::std::nullopt;
+			}
+			value = value * base + digit;
+		}
+		if (digits == 0)
+		{
+			return ::std::nullopt;
+		}
+		return value;
+	}
+
+	// value of decimal floating point sequence, separators are skipped.
+	// Clinger's fast path: when significand (at most 2^53) and power of 10 (at most 10^22) are both exact in f64,
+	// one multiplication or division rounds to the correct result.
+	// returns nullopt for other sequences and caller falls back to from_chars.
+	inline auto scan_decimal_floating_point(::std::string_view seq) noexcept -> ::std::optional<type::f64>
+	{
+		if constexpr (!::std::numeric_limits<type::f64>::is_iec559 || FLT_EVAL_METHOD != 0)
+		{
+			return ::std::nullopt; // no exact rounding guarantee
+		}
+		constexpr type::f64 exact_powers_of_10[]{
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		constexpr int       max_exact_exponent{ 22 };
+		constexpr type::u64 max_exact_significand{ type::u64{ 1 } << 53 };
+
+		type::u64     significand{};
+		::std::size_t significant_digits{};
+		bool          has_digit{};
+		int           exponent{};
+		auto          it   = seq.begin();
+		const auto    last = seq.end();
+		auto scan_significand_digits = [&](bool is_fraction) -> bool
+		{
+			for (; it != last; ++it)
+			{
+				if (*it == '\'')
+				{
+					continue;
+				}
+				const auto digit = digit_value(*it);
+				if (digit >= 10)
+				{
+					break;
+				}
+				has_digit = true;
+				if (is_fraction)
+				{
+					--exponent;
+				}
+				if (significand == 0 && digit == 0)
+				{
+					continue; // leading zeros
+				}
+				if (++significant_digits > 19)
+				{
+					return false;
+				}
+				significand = significand * 10 + digit;
+			}
+			return true;
+		};
+		if (!scan_significand_digits(false))
+		{
+			return ::std::nullopt;
+		}
+		if (it != last && *it == '.')
+		{
+			++it;
+			if (!scan_significand_digits(true))
+			{
+				return ::std::nullopt;
+			}
+		}
+		if (!has_digit)
+		{
+			return ::std::nullopt;
+		}
+		if (it != last && (*it == 'e' || *it == 'E'))
+		{
+			++it;
+			const bool is_negative = it != last && *it == '-';
+			if (it != last && (*it == '-' || *it == '+'))
+			{
+				++it;
+			}
+			int           exp_value{};
+			::std::size_t exp_digits{};
+			for (; it != last; ++it)
+			{
+				if (*it == '\'')
+				{
+					continue;
+				}
+				const auto digit = digit_value(*it);
+				if (digit >= 10 || ++exp_digits > 4)
+				{
+					return ::std::nullopt;
+				}
+				exp_value = exp_value * 10 + static_cast<int>(digit);
+			}
+			if (exp_digits == 0)
+			{
+				return ::std::nullopt;
+			}
+			exponent += is_negative ? -exp_value : exp_value;
+		}
+		if (it != last)
+		{
+			return ::std::nullopt;
+		}
+		if (significand == 0)
+		{
+			return type::f64{};
+		}
+		if (significand > max_exact_significand || exponent < -max_exact_exponent || exponent > max_exact_exponent)
+		{
+			return ::std::nullopt;
+		}
+		const auto value = static_cast<type::f64>(significand);
+		return exponent < 0 ? value / exact_powers_of_10[-exponent] : value * exact_powers_of_10[exponent];
+	}
+
 	inline auto to_raw_err_str(error_msg_string err_msg_str) -> raw_error_message_type::error_string
 	{
 		return raw_error_message_type::error_string{ ::std::move(err_msg_str) };
@@ -957,6 +1168,96 @@ namespace pdn::detail
 		}
 	}
 
+	// append code points to text, ASCII runs are converted in bulk
+	template <typename char_t>
+	inline void append_code_points(type::string<char_t>& text, ::std::span<const unicode::code_point_t> code_points)
+	{
+		auto       it   = code_points.data();
+		const auto last = it + code_points.size();
+		while (it != last)
+		{
+			const auto ascii_count = unicode::simd::ascii_prefix_length(it, last);
+			if (ascii_count != 0)
+			{
+				const auto old_size = text.size();
+				text.resize(old_size + ascii_count);
+				unicode::simd::convert_ascii(it, ascii_count, text.data() + old_size);
+				it += ascii_count;
+				continue;
+			}
+			auto encode_r = unicode::encode<char_t>(*it);
+			assert((bool)encode_r && "encode failed");
+			text.append(encode_r.cbegin(), encode_r.cend());
+			++it;
+		}
+	}
+
+	// in bodies of string-like literals and comments, dfa stays in same state until one of few code points is reached,
+	// so code points before it are skipped at once.
+	// returns count of them, is_text is set false in bodies of comments.
+	inline auto count_plain_code_points(dfa_state_code state, ::std::span<const unicode::code_point_t> code_points, bool& is_text) -> ::std::size_t
+	{
+		using enum dfa_state_code;
+		const auto first = code_points.data();
+		const auto last  = first + code_points.size();
+		is_text = true;
+		switch (state)
+		{
+		case string:
+			return unicode::simd::find_code_point(first, last, { U'\"', U'\\', U'\n' });
+		case identifier_string:
+			return unicode::simd::find_code_point(first, last, { U'`', U'\\', U'\n' });
+		case raw_string:
+		case identifier_raw_string:
+			return unicode::simd::find_code_point(first, last, { U')', U'\r' });
+		case line_comment:
+			is_text = false;
+			return unicode::simd::find_code_point(first, last, { U'\n', U'\r', U'\u0085', U'\u2028', U'\u2029' });
+		case block_comment:
+			is_text = false;
+			return unicode::simd::find_code_point(first, last, { U'*' });
+		case nested_block_comment:
+			is_text = false;
+			return unicode::simd::find_code_point(first, last, { U'<', U'/' });
+		default:
+			return 0;
+		}
+	}
+
+	// skips plain code points, and appends them to text for literals.
+	// returns false when current code point should be processed by dfa.
+	template <typename char_t, staged_code_point_iterator it_t>
+	inline bool skip_plain_code_points(dfa_state_code state, it_t& it, type::string<char_t>& text)
+	{
+		const auto code_points = it.staged_code_points();
+		bool       is_text{};
+		const auto count = count_plain_code_points(state, code_points, is_text);
+		if (count == 0)
+		{
+			return false;
+		}
+		if (is_text)
+		{
+			append_code_points(text, code_points.first(count));
+		}
+		it.skip_code_points(count);
+		return true;
+	}
+
+	// skips plain code points without text, for skipping mode of lexer
+	template <staged_code_point_iterator it_t>
+	inline bool skip_plain_code_points(dfa_state_code state, it_t& it)
+	{
+		bool       is_text{};
+		const auto count = count_plain_code_points(state, it.staged_code_points(), is_text);
+		if (count == 0)
+		{
+			return false;
+		}
+		it.skip_code_points(count);
+		return true;
+	}
+
 	template <concepts::function_package_for_lexer function_package>
 	class lexer_helper
 	{
@@ -977,340 +1278,170 @@ namespace pdn::detail
 	private:
 		function_package* func_pkg{};
 	};
+
+	// helper for skipping mode of lexer, errors are dropped
+	template <concepts::function_package_for_lexer function_package>
+	class silent_lexer_helper
+	{
+	public:
+		explicit silent_lexer_helper(lexer_helper<function_package>& helper) : base{ &helper } {}
+		auto get_pos() -> source_position
+		{
+			return base->get_pos();
+		}
+		void post_err(source_position, auto, raw_error_message_variant&&) {}
+	private:
+		lexer_helper<function_package>* base{};
+	};
+
+	// policies of dfa driver of lexer (lexer::run_dfa).
+	// storing policy keeps text and number sequence of token for value of token, errors go to lexer_helper;
+	// skipping policy keeps nothing, errors go to silent_lexer_helper and are dropped.
+	template <typename char_t, concepts::function_package_for_lexer function_package>
+	class storing_lexer_policy
+	{
+	public:
+		storing_lexer_policy(lexer_helper<function_package>& helper, type::string<char_t>& text, ::std::string& number_sequence)
+			: sink{ &helper }, text_ptr{ &text }, number_sequence_ptr{ &number_sequence } {}
+		auto error_sink() -> lexer_helper<function_package>&
+		{
+			return *sink;
+		}
+		auto text() const -> const type::string<char_t>&
+		{
+			return *text_ptr;
+		}
+		auto number_sequence() const -> const ::std::string&
+		{
+			return *number_sequence_ptr;
+		}
+		bool skip_plain_code_points(dfa_state_code state, auto& it)
+		{
+			return detail::skip_plain_code_points(state, it, *text_ptr);
+		}
+		void append(unicode::code_point_t c)
+		{
+			auto encode_r = unicode::encode<char_t>(c);
+			assert((bool)encode_r && "encode failed");
+			text_ptr->append(encode_r.cbegin(), encode_r.cend());
+		}
+		void append(unicode::ucpstring_view code_points)
+		{
+			append_code_points(*text_ptr, code_points);
+		}
+		void append_number(unicode::code_point_t c)
+		{
+			*number_sequence_ptr += char(c); // Unicode[U+0000, U+007f] -> ASCII -> form_chars
+		}
+	private:
+		lexer_helper<function_package>* sink{};
+		type::string<char_t>*           text_ptr{};
+		::std::string*                  number_sequence_ptr{};
+	};
+
+	template <typename char_t, concepts::function_package_for_lexer function_package>
+	class skipping_lexer_policy
+	{
+	public:
+		// text and number sequence are never appended, they stay empty for error messages which are dropped
+		skipping_lexer_policy(lexer_helper<function_package>& helper, type::string<char_t>& text, ::std::string& number_sequence)
+			: sink{ helper }, text_ptr{ &text }, number_sequence_ptr{ &number_sequence } {}
+		auto error_sink() -> silent_lexer_helper<function_package>&
+		{
+			return sink;
+		}
+		auto text() const -> const type::string<char_t>&
+		{
+			return *text_ptr;
+		}
+		auto number_sequence() const -> const ::std::string&
+		{
+			return *number_sequence_ptr;
+		}
+		bool skip_plain_code_points(dfa_state_code state, auto& it)
+		{
+			return detail::skip_plain_code_points(state, it);
+		}
+		void append(unicode::code_point_t) {}
+		void append(unicode::ucpstring_view) {}
+		void append_number(unicode::code_point_t) {}
+	private:
+		silent_lexer_helper<function_package> sink;
+		const type::string<char_t>*           text_ptr{};
+		const ::std::string*                  number_sequence_ptr{};
+	};
 }
 
 namespace pdn
 {
-	template <unicode::concepts::code_unit char_t, concepts::function_package_for_lexer function_package>
+	template <unicode::concepts::code_unit char_t, concepts::function_package_for_lexer function_package, typename dfa_engine_t>
 	class lexer
 	{
 	public:
 		token<char_t> get_token(auto&& begin, auto end)
 		{
 			token<char_t>              result{};
-			type::string<char_t>      text{};            // rename text
-			unicode::ucpstring         open_d_seq{};      // delimiter-sequence for raw string
-			::std::string              number_sequence{}; // Unicode[U+0000, U+007f] -> ASCII -> form_chars
-			::std::size_t              nested_block_comment_layer{};
-			::std::size_t              cont_n_delimiter_count{}; // consecutive number delimiters' count
-			source_position            position{ helper.get_pos() };
-			auto                       dfa_state = dfa_state_objects::start_state();
+			type::string<char_t>&     text            = text_buffer;            // rename text
+			unicode::ucpstring&        open_d_seq      = open_d_seq_buffer;      // delimiter-sequence for raw string
+			::std::string&             number_sequence = number_sequence_buffer; // Unicode[U+0000, U+007f] -> ASCII -> form_chars
+			source_position            position{};
+			auto                       policy    = detail::storing_lexer_policy<char_t, function_package>{ helper, text, number_sequence };
+			auto                       dfa_state = run_dfa(begin, end, policy, position);
 
 			auto num_seq_to_ems = [&]() { return reinterpret_to_err_msg_str(number_sequence); };
-			auto append = [](type::string<char_t>& src, unicode::code_point_t c)
-			{
-				auto encode_r = unicode::encode<char_t>(c);
-				assert((bool)encode_r && "encode failed");
-				src.append(encode_r.cbegin(), encode_r.cend());
-			};
 
 			using unicode::code_convert;
 			using lex_ec = lexical_error_code;
-			using err_ms = error_msg_string;
-
-			while (begin != end)
-			{
-				auto c = *begin;
-
-				if (!unicode::is_scalar_value(c))
-				{
-					using raw_err = raw_error_message_type::not_unicode_scalar_value;
-					helper.post_err(helper.get_pos(), lex_ec::not_unicode_scalar_value, raw_err{ c });
-					++begin;
-					continue;
-				}
-
-				auto new_dfa_state = dfa_state.transformer(c);
-
-				auto update_token_pos = [&]()
-				{
-					auto prev = dfa_state.state_code;
-					auto next = new_dfa_state.state_code;
-					if (detail::is_non_token_state(prev) && detail::is_token_state(next))
-					{
-						position = helper.get_pos();
-					}
-				};
-
-				update_token_pos();
 
-				using enum dfa_state_code;
-				switch (new_dfa_state.state_code)
-				{
-					// stop dfa and make token
-				case unmatched:
-					goto label_out_of_loop;
+			// Make token now.
+			// The processing of text needs to be done in a non-default case,
+			//     for example, a char sequence of integer needs to be converted to an integer.
+			// Other final-states go into the default case without additional processing.
+			// If the non-final state goes to default, an internal error is reported.
+			// The error status must be handled in a non-default case (at least the error needs to be reported).
 
-					// error state
+			result.code = dfa_state.token_code;
+			result.position = position;
 
-					// accept non-comments, non-whitespace characters, non-first-char-of-tokens from the Start state
-				case unacceptable_character:
-				{
-					new_dfa_state = dfa_state_objects::start_state();
-					auto cp = unicode::code_point_t(c);
-					auto view = unicode::ucpstring_view{ &cp, 1 };
-					helper.post_err(helper.get_pos(),
-					                lex_ec::unacceptable_character,
-					                detail::to_raw_err_str(code_convert<err_ms>(view)));
-					break;
-				}
-				case infinity:
+			using enum dfa_state_code;
+			switch (dfa_state.state_code)
+			{
+				// ERROR STATES vvv
+			case block_comment:
+			case block_comment_closing:
+				helper.post_err(position, lexical_error_code::unterminated_block_comment, {});
+				break;
+			case nested_block_comment:
+			case nested_block_comment_nesting:
+			case nested_block_comment_nested:
+			case nested_block_comment_closing:
+			case nested_block_comment_closed:
+				helper.post_err(position, lex_ec::unterminated_nested_block_comment, {});
+				break;
+			case identifier_string_opened:
+			case identifier_string:
+			case string_opened:
+			case string:
+			case identifier_raw_string:
+			case raw_string:
+				detail::process_string_like_error(dfa_state.state_code, position, detail::to_err_ms<char_t>(text), open_d_seq, helper);
+				[[fallthrough]];
+				// ERROR STATES ^^^
+			case identifier:
+			case identifier_string_closed:
+			case string_closed:
+			case raw_string_closed:
+			case identifier_raw_string_closed:
+				result.value = make_proxy<type::string<char_t>>(text);
+				break;
+			case at_identifier:
+				if constexpr (::std::same_as<char_t, unicode::u8char_t>)
 				{
-					using namespace unicode_literals;
-					using ct = char_t;
-					text = type::string<ct>{ ct('i'), ct('n'), ct('f'), ct('i'), ct('n'), ct('i'), ct('t'), ct('y') };
-					new_dfa_state.state_code = dfa_state_objects::at_identifier.state_code;
-					new_dfa_state.token_code = dfa_state_objects::at_identifier.token_code;
-					break;
+					result.value = detail::at_iden_string_proxy{ text };
 				}
-				case identifier_string_with_LF:
+				else
 				{
-					new_dfa_state = dfa_state_objects::identifier_string_closed;
-					helper.post_err(position, lex_ec::identifier_string_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(text)));
-					goto label_update_dfa_state;
-				}
-				case string_with_LF:
-				{
-					new_dfa_state = dfa_state_objects::string_closed;
-					helper.post_err(position, lex_ec::string_literal_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(text)));
-					goto label_update_dfa_state;
-				}
-				case character_with_LF:
-				{
-					new_dfa_state = dfa_state_objects::character_closed;
-					helper.post_err(position, lex_ec::character_literal_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(text)));
-					goto label_update_dfa_state;
-				}
-				case start:
-				case line_comment:
-				case block_comment:
-				case block_comment_closing:
-				case nested_block_comment:
-				case nested_block_comment_nesting:
-				case nested_block_comment_closing:
-					break;
-				case nested_block_comment_nested:
-					++nested_block_comment_layer;
-					break;
-				case nested_block_comment_closed:
-					--nested_block_comment_layer;
-					if (nested_block_comment_layer == 0)
-					{
-						new_dfa_state = dfa_state_objects::start_state();
-					}
-					break;
-				case identifier:
-				case identifier_string:
-				case string:
-				case character:
-				case at_identifier:
-				case raw_string:
-				case identifier_raw_string:
-					append(text, c);
-					break;
-				case identifier_string_escape:
-					++begin;
-					new_dfa_state = dfa_state_objects::identifier_string;
-					if (detail::get_escape(c, begin, end, true, helper))
-					{
-						append(text, c);
-					}
-					goto label_update_dfa_state;
-				case string_escape:
-					++begin;
-					new_dfa_state = dfa_state_objects::string;
-					if (detail::get_escape(c, begin, end, false, helper))
-					{
-						append(text, c);
-					}
-					goto label_update_dfa_state;
-				case character_escape:
-					++begin;
-					new_dfa_state = dfa_state_objects::character;
-					if (detail::get_escape(c, begin, end, false, helper))
-					{
-						append(text, c);
-					}
-					goto label_update_dfa_state;
-				case raw_string_d_seq_opened:
-					++begin;
-					// @"d_seq()d_seq"
-					//  ^ -> to first d sequence character or '('
-					detail::get_raw_string_opening_d_seq(open_d_seq, begin, end, false, helper);
-					new_dfa_state = dfa_state_objects::raw_string;
-					goto label_update_dfa_state;
-				case raw_string_received_CR:
-					++begin;
-					if (begin == end)
-					{
-						text += char_t('\r');
-						new_dfa_state = dfa_state_objects::raw_string;
-						goto label_update_dfa_state;
-					}
-					c = *begin;
-					if (c != U'\n')
-					{
-						text += char_t('\r');
-					}
-					append(text, c);
-					new_dfa_state = dfa_state_objects::raw_string;
-					goto label_move_iterator;
-				case raw_string_received_right_parentheses:
-				{
-					unicode::ucpstring close_d_seq{};
-					++begin;
-					if (detail::get_raw_string_closing_d_seq(open_d_seq, close_d_seq, begin, end, U'"'))
-					{
-						new_dfa_state = dfa_state_objects::raw_string_closed;
-					}
-					else
-					{
-						text += char_t(')');
-						text += unicode::code_convert<type::string<char_t>>(close_d_seq);
-						new_dfa_state = dfa_state_objects::raw_string;
-					}
-					goto label_update_dfa_state;
-				}
-				case identifier_raw_string_d_seq_opened:
-					++begin;
-					// @`d_seq()d_seq`
-					//  ^ -> to first d sequence character or '('
-					detail::get_raw_string_opening_d_seq(open_d_seq, begin, end, true, helper);
-					new_dfa_state = dfa_state_objects::identifier_raw_string;
-					goto label_update_dfa_state;
-				case identifier_raw_string_received_CR:
-					++begin;
-					if (begin == end)
-					{
-						text += char_t('\r');
-						new_dfa_state = dfa_state_objects::identifier_raw_string;
-						goto label_update_dfa_state;
-					}
-					c = *begin;
-					if (c != U'\n')
-					{
-						text += char_t('\r');
-					}
-					append(text, c);
-					new_dfa_state = dfa_state_objects::identifier_raw_string;
-					goto label_move_iterator;
-				case identifier_raw_string_received_right_parentheses:
-				{
-					unicode::ucpstring close_d_seq{};
-					++begin;
-					if (detail::get_raw_string_closing_d_seq(open_d_seq, close_d_seq, begin, end, U'`'))
-					{
-						new_dfa_state = dfa_state_objects::identifier_raw_string_closed;
-					}
-					else
-					{
-						text += char_t(')');
-						text += unicode::code_convert<type::string<char_t>>(close_d_seq);
-						new_dfa_state = dfa_state_objects::identifier_raw_string;
-					}
-					goto label_update_dfa_state;
-				}
-				case zero:
-				case dot:
-				case dec_seq:
-				case fp_dec_part_first_after_dec_with_dot:
-				case fp_exp_sign_or_first:
-				case fp_exp_first:
-				case bin_seq_first:
-				case hex_seq_first:
-				case hex_fp_dec_part_first_after_hex_with_dot:
-				case hex_fp_dec_part:
-				case hex_fp_exp_sign_or_first:
-				case hex_fp_exp_first:
-				case hex_fp_seq_start_with_0x_dot:
-				case fp_dec_part:
-				case fp_exp:
-				case oct_seq:
-				case dec_seq_start_with_0:
-				case bin_seq:
-				case hex_seq:
-				case hex_fp_exp:
-					number_sequence += char(c);
-					if (cont_n_delimiter_count > 1)
-					{
-						helper.post_err(helper.get_pos(),
-						                lex_ec::more_than_one_separators_between_numbers,
-						                detail::to_raw_err_str(num_seq_to_ems()));
-					}
-					cont_n_delimiter_count = 0;
-					break;
-				case dec_seq_with_quote:
-				case fp_dec_part_with_quote:
-				case fp_exp_with_quote:
-				case oct_seq_with_quote:
-				case dec_seq_start_with_0_with_quote:
-				case bin_seq_with_quote:
-				case hex_seq_with_quote:
-				case hex_fp_dec_part_with_quote:
-				case hex_fp_exp_with_quote:
-					number_sequence += char(c);
-					++cont_n_delimiter_count;
-					break;
-				default:
-					break;
-				}
-			label_move_iterator:
-				++begin;
-			label_update_dfa_state:
-				dfa_state = new_dfa_state;
-			}
-
-		label_out_of_loop:
-
-			// Make token now.
-			// The processing of text needs to be done in a non-default case,
-			//     for example, a char sequence of integer needs to be converted to an integer.
-			// Other final-states go into the default case without additional processing.
-			// If the non-final state goes to default, an internal error is reported.
-			// The error status must be handled in a non-default case (at least the error needs to be reported).
-
-			result.code = dfa_state.token_code;
-			result.position = position;
-
-			using enum dfa_state_code;
-			switch (dfa_state.state_code)
-			{
-				// ERROR STATES vvv
-			case block_comment:
-			case block_comment_closing:
-				helper.post_err(position, lexical_error_code::unterminated_block_comment, {});
-				break;
-			case nested_block_comment:
-			case nested_block_comment_nesting:
-			case nested_block_comment_nested:
-			case nested_block_comment_closing:
-			case nested_block_comment_closed:
-				helper.post_err(position, lex_ec::unterminated_nested_block_comment, {});
-				break;
-			case identifier_string_opened:
-			case identifier_string:
-			case string_opened:
-			case string:
-			case identifier_raw_string:
-			case raw_string:
-				detail::process_string_like_error(dfa_state.state_code, position, detail::to_err_ms<char_t>(text), open_d_seq, helper);
-				[[fallthrough]];
-				// ERROR STATES ^^^
-			case identifier:
-			case identifier_string_closed:
-			case string_closed:
-			case raw_string_closed:
-			case identifier_raw_string_closed:
-				result.value = make_proxy<type::string<char_t>>(::std::move(text));
-				break;
-			case at_identifier:
-				if constexpr (::std::same_as<char_t, unicode::u8char_t>)
-				{
-					result.value = detail::at_iden_string_proxy{ ::std::move(text) };
-				}
-				else
-				{
-					result.value = detail::at_iden_string_proxy{ code_convert<unicode::u8string>(text) };
+					result.value = detail::at_iden_string_proxy{ code_convert<unicode::u8string>(text) };
 				}
 				break;
 			case character_opened: // <<< ERROR STATE
@@ -1327,6 +1458,11 @@ namespace pdn
 				[[fallthrough]];
 			case dec_seq:
 			{
+				if (auto value = detail::scan_unsigned_integer(number_sequence, 10)) [[likely]]
+				{
+					detail::to_appropriate_int_type<char_t>(result.value, *value);
+					break;
+				}
 				::std::uint_least64_t integer_value{};
 				detail::remove_all_separator(number_sequence);
 				const auto& n_seq = number_sequence;
@@ -1359,6 +1495,11 @@ namespace pdn
 			case fp_dec_part:
 			case fp_exp:
 			{
+				if (auto value = detail::scan_decimal_floating_point(number_sequence)) [[likely]]
+				{
+					result.value = *value;
+					break;
+				}
 				type::f64 fp_value{};
 				detail::remove_all_separator(number_sequence);
 				const auto& n_seq = number_sequence;
@@ -1381,6 +1522,11 @@ namespace pdn
 			case zero:
 			case oct_seq:
 			{
+				if (auto value = detail::scan_unsigned_integer(number_sequence, 8)) [[likely]]
+				{
+					detail::to_appropriate_int_type<char_t>(result.value, *value);
+					break;
+				}
 				::std::uint_least64_t integer_value{};
 				detail::remove_all_separator(number_sequence);
 				const auto& n_seq = number_sequence;
@@ -1410,6 +1556,11 @@ namespace pdn
 			case bin_seq:
 			{
 				assert(detail::check_0b_prefix(number_sequence) && "binary literal without prefix");
+				if (auto value = detail::scan_unsigned_integer(::std::string_view{ number_sequence }.substr(2), 2)) [[likely]]
+				{
+					detail::to_appropriate_int_type<char_t>(result.value, *value);
+					break;
+				}
 				type::u64 integer_value{};
 				detail::remove_all_separator(number_sequence);
 				auto n_seq = ::std::string_view{ number_sequence.begin() + 2, number_sequence.end() };
@@ -1439,6 +1590,11 @@ namespace pdn
 			case hex_seq:
 			{
 				assert(detail::check_0x_prefix(number_sequence) && "hexadecimal literal without prefix");
+				if (auto value = detail::scan_unsigned_integer(::std::string_view{ number_sequence }.substr(2), 16)) [[likely]]
+				{
+					detail::to_appropriate_int_type<char_t>(result.value, *value);
+					break;
+				}
 				type::u64 integer_value{};
 				detail::remove_all_separator(number_sequence);
 				auto n_seq = ::std::string_view{ number_sequence.begin() + 2, number_sequence.end() };
@@ -1484,9 +1640,311 @@ namespace pdn
 			return result;
 		}
 
+		// skipping mode, for tokens which will be dropped by parser.
+		// same dfa as get_token, but value of token is not made, only code and position of token are kept:
+		// text is not stored, numbers are not converted, and lexical errors are not reported.
+		token<char_t> skip_token(auto&& begin, auto end)
+		{
+			source_position position{};
+			auto            policy    = detail::skipping_lexer_policy<char_t, function_package>{ helper, text_buffer, number_sequence_buffer };
+			auto            dfa_state = run_dfa(begin, end, policy, position);
+			return token<char_t>{ .position = position, .code = dfa_state.token_code, .value = {} };
+		}
+
 		explicit lexer(function_package& function_pkg) : helper{ function_pkg } {}
 	private:
+		// dfa driver of get_token and skip_token, runs dfa from start state until it stops, and returns final state.
+		// policy keeps text of token or not, and is sink of lexical errors (see detail::storing_lexer_policy).
+		// position is set to position of first code point of token.
+		auto run_dfa(auto& begin, auto end, auto& policy, source_position& position)
+		{
+			::std::size_t nested_block_comment_layer{};
+			::std::size_t cont_n_delimiter_count{}; // consecutive number delimiters' count
+			auto          dfa_state   = dfa_state_objects::start_state();
+			const auto&   transitions = dfa_engine_t::instance();
+			auto&         sink        = policy.error_sink();
+			auto&         open_d_seq  = open_d_seq_buffer; // delimiter-sequence for raw string
+
+			// scratch buffers are cleared but keep their capacity, payload of token is copied out of them
+			text_buffer.clear();
+			open_d_seq.clear();
+			number_sequence_buffer.clear();
+			position = sink.get_pos();
+
+			using unicode::code_convert;
+			using lex_ec = lexical_error_code;
+			using err_ms = error_msg_string;
+
+			while (begin != end)
+			{
+				if constexpr (detail::staged_code_point_iterator<::std::remove_cvref_t<decltype(begin)>>)
+				{
+					if (policy.skip_plain_code_points(dfa_state.state_code, begin))
+					{
+						continue;
+					}
+				}
+
+				auto c = *begin;
+
+				if (!unicode::is_scalar_value(c))
+				{
+					using raw_err = raw_error_message_type::not_unicode_scalar_value;
+					sink.post_err(sink.get_pos(), lex_ec::not_unicode_scalar_value, raw_err{ c });
+					++begin;
+					continue;
+				}
+
+				auto new_dfa_state = transitions.transform(dfa_state, c);
+
+				auto update_token_pos = [&]()
+				{
+					auto prev = dfa_state.state_code;
+					auto next = new_dfa_state.state_code;
+					if (detail::is_non_token_state(prev) && detail::is_token_state(next))
+					{
+						position = sink.get_pos();
+					}
+				};
+
+				update_token_pos();
+
+				using enum dfa_state_code;
+				switch (new_dfa_state.state_code)
+				{
+					// stop dfa and make token
+				case unmatched:
+					goto label_out_of_loop;
+
+					// error state
+
+					// accept non-comments, non-whitespace characters, non-first-char-of-tokens from the Start state
+				case unacceptable_character:
+				{
+					new_dfa_state = dfa_state_objects::start_state();
+					auto cp = unicode::code_point_t(c);
+					auto view = unicode::ucpstring_view{ &cp, 1 };
+					sink.post_err(sink.get_pos(),
+					              lex_ec::unacceptable_character,
+					              detail::to_raw_err_str(code_convert<err_ms>(view)));
+					break;
+				}
+				case infinity:
+				{
+					policy.append(U"infinity"); // text is empty, infinity is only reached from start state
+					break; // infinity is made as at_identifier token when dfa stops
+				}
+				case identifier_string_with_LF:
+				{
+					new_dfa_state = dfa_state_objects::identifier_string_closed;
+					sink.post_err(position, lex_ec::identifier_string_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(policy.text())));
+					goto label_update_dfa_state;
+				}
+				case string_with_LF:
+				{
+					new_dfa_state = dfa_state_objects::string_closed;
+					sink.post_err(position, lex_ec::string_literal_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(policy.text())));
+					goto label_update_dfa_state;
+				}
+				case character_with_LF:
+				{
+					new_dfa_state = dfa_state_objects::character_closed;
+					sink.post_err(position, lex_ec::character_literal_terminated_by_LF, detail::to_raw_err_str(code_convert<err_ms>(policy.text())));
+					goto label_update_dfa_state;
+				}
+				case start:
+				case line_comment:
+				case block_comment:
+				case block_comment_closing:
+				case nested_block_comment:
+				case nested_block_comment_nesting:
+				case nested_block_comment_closing:
+					break;
+				case nested_block_comment_nested:
+					++nested_block_comment_layer;
+					break;
+				case nested_block_comment_closed:
+					--nested_block_comment_layer;
+					if (nested_block_comment_layer == 0)
+					{
+						new_dfa_state = dfa_state_objects::start_state();
+					}
+					break;
+				case identifier:
+				case identifier_string:
+				case string:
+				case character:
+				case at_identifier:
+				case raw_string:
+				case identifier_raw_string:
+					policy.append(c);
+					break;
+				case identifier_string_escape:
+					++begin;
+					new_dfa_state = dfa_state_objects::identifier_string;
+					if (detail::get_escape(c, begin, end, true, sink))
+					{
+						policy.append(c);
+					}
+					goto label_update_dfa_state;
+				case string_escape:
+					++begin;
+					new_dfa_state = dfa_state_objects::string;
+					if (detail::get_escape(c, begin, end, false, sink))
+					{
+						policy.append(c);
+					}
+					goto label_update_dfa_state;
+				case character_escape:
+					++begin;
+					new_dfa_state = dfa_state_objects::character;
+					if (detail::get_escape(c, begin, end, false, sink))
+					{
+						policy.append(c);
+					}
+					goto label_update_dfa_state;
+				case raw_string_d_seq_opened:
+					++begin;
+					// @"d_seq()d_seq"
+					//  ^ -> to first d sequence character or '('
+					detail::get_raw_string_opening_d_seq(open_d_seq, begin, end, false, sink);
+					new_dfa_state = dfa_state_objects::raw_string;
+					goto label_update_dfa_state;
+				case raw_string_received_CR:
+					++begin;
+					if (begin == end)
+					{
+						policy.append(U'\r');
+						new_dfa_state = dfa_state_objects::raw_string;
+						goto label_update_dfa_state;
+					}
+					c = *begin;
+					if (c != U'\n')
+					{
+						policy.append(U'\r');
+					}
+					policy.append(c);
+					new_dfa_state = dfa_state_objects::raw_string;
+					goto label_move_iterator;
+				case raw_string_received_right_parentheses:
+				{
+					unicode::ucpstring close_d_seq{};
+					++begin;
+					if (detail::get_raw_string_closing_d_seq(open_d_seq, close_d_seq, begin, end, U'"'))
+					{
+						new_dfa_state = dfa_state_objects::raw_string_closed;
+					}
+					else
+					{
+						policy.append(U')');
+						policy.append(close_d_seq);
+						new_dfa_state = dfa_state_objects::raw_string;
+					}
+					goto label_update_dfa_state;
+				}
+				case identifier_raw_string_d_seq_opened:
+					++begin;
+					// @`d_seq()d_seq`
+					//  ^ -> to first d sequence character or '('
+					detail::get_raw_string_opening_d_seq(open_d_seq, begin, end, true, sink);
+					new_dfa_state = dfa_state_objects::identifier_raw_string;
+					goto label_update_dfa_state;
+				case identifier_raw_string_received_CR:
+					++begin;
+					if (begin == end)
+					{
+						policy.append(U'\r');
+						new_dfa_state = dfa_state_objects::identifier_raw_string;
+						goto label_update_dfa_state;
+					}
+					c = *begin;
+					if (c != U'\n')
+					{
+						policy.append(U'\r');
+					}
+					policy.append(c);
+					new_dfa_state = dfa_state_objects::identifier_raw_string;
+					goto label_move_iterator;
+				case identifier_raw_string_received_right_parentheses:
+				{
+					unicode::ucpstring close_d_seq{};
+					++begin;
+					if (detail::get_raw_string_closing_d_seq(open_d_seq, close_d_seq, begin, end, U'`'))
+					{
+						new_dfa_state = dfa_state_objects::identifier_raw_string_closed;
+					}
+					else
+					{
+						policy.append(U')');
+						policy.append(close_d_seq);
+						new_dfa_state = dfa_state_objects::identifier_raw_string;
+					}
+					goto label_update_dfa_state;
+				}
+				case zero:
+				case dot:
+				case dec_seq:
+				case fp_dec_part_first_after_dec_with_dot:
+				case fp_exp_sign_or_first:
+				case fp_exp_first:
+				case bin_seq_first:
+				case hex_seq_first:
+				case hex_fp_dec_part_first_after_hex_with_dot:
+				case hex_fp_dec_part:
+				case hex_fp_exp_sign_or_first:
+				case hex_fp_exp_first:
+				case hex_fp_seq_start_with_0x_dot:
+				case fp_dec_part:
+				case fp_exp:
+				case oct_seq:
+				case dec_seq_start_with_0:
+				case bin_seq:
+				case hex_seq:
+				case hex_fp_exp:
+					policy.append_number(c);
+					if (cont_n_delimiter_count > 1)
+					{
+						sink.post_err(sink.get_pos(),
+						              lex_ec::more_than_one_separators_between_numbers,
+						              detail::to_raw_err_str(reinterpret_to_err_msg_str(policy.number_sequence())));
+					}
+					cont_n_delimiter_count = 0;
+					break;
+				case dec_seq_with_quote:
+				case fp_dec_part_with_quote:
+				case fp_exp_with_quote:
+				case oct_seq_with_quote:
+				case dec_seq_start_with_0_with_quote:
+				case bin_seq_with_quote:
+				case hex_seq_with_quote:
+				case hex_fp_dec_part_with_quote:
+				case hex_fp_exp_with_quote:
+					policy.append_number(c);
+					++cont_n_delimiter_count;
+					break;
+				default:
+					break;
+				}
+			label_move_iterator:
+				++begin;
+			label_update_dfa_state:
+				dfa_state = new_dfa_state;
+			}
+
+		label_out_of_loop:
+
+			// code point U+221E is token @infinity
+			if (dfa_state.state_code == dfa_state_code::infinity)
+			{
+				dfa_state = dfa_state_objects::at_identifier;
+			}
+			return dfa_state;
+		}
+
 		detail::lexer_helper<function_package> helper{};
+		type::string<char_t>                   text_buffer{};            // scratch buffer of text, reused by each token
+		unicode::ucpstring                     open_d_seq_buffer{};      // scratch buffer of delimiter-sequence of raw string
+		::std::string                          number_sequence_buffer{}; // scratch buffer of number sequence
 	};
 }
 
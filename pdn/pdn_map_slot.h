@@ -0,0 +1,52 @@
+#ifndef PDN_Header_pdn_map_slot
+#define PDN_Header_pdn_map_slot
+
+#include <utility>
+#include <memory>
+#include <type_traits>
+
+namespace pdn::type::detail
+{
+	// slot of entry of ordered_map and flat_map, as abseil does for its maps:
+	// entry is made, moved and destroyed as pair<key_t, val_t>, so key is moved instead of copied when map relocates it,
+	// and map hands it out as pair<const key_t, val_t> through value, so key cannot be changed through map.
+	template <typename key_t, typename val_t>
+	union map_slot
+	{
+		using value_type         = ::std::pair<const key_t, val_t>;
+		using mutable_value_type = ::std::pair<key_t, val_t>;
+
+		value_type         value;
+		mutable_value_type mutable_value;
+
+		template <typename... args_t>
+		explicit map_slot(::std::piecewise_construct_t, args_t&&... args)
+		{
+			::std::construct_at(&mutable_value, ::std::piecewise_construct, ::std::forward<args_t>(args)...);
+		}
+		map_slot(const map_slot& o)
+		{
+			::std::construct_at(&mutable_value, o.mutable_value);
+		}
+		map_slot(map_slot&& o) noexcept(::std::is_nothrow_move_constructible_v<mutable_value_type>)
+		{
+			::std::construct_at(&mutable_value, ::std::move(o.mutable_value));
+		}
+		map_slot& operator=(const map_slot& o)
+		{
+			mutable_value = o.mutable_value;
+			return *this;
+		}
+		map_slot& operator=(map_slot&& o) noexcept(::std::is_nothrow_move_assignable_v<mutable_value_type>)
+		{
+			mutable_value = ::std::move(o.mutable_value);
+			return *this;
+		}
+		~map_slot()
+		{
+			::std::destroy_at(&mutable_value);
+		}
+	};
+}
+
+#endif
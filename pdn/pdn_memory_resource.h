@@ -0,0 +1,105 @@
+#ifndef PDN_Header_pdn_memory_resource
+#define PDN_Header_pdn_memory_resource
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <type_traits>
+
+namespace pdn::detail
+{
+	inline auto current_memory_resource_ref() noexcept -> ::std::pmr::memory_resource*&
+	{
+		thread_local ::std::pmr::memory_resource* resource = ::std::pmr::new_delete_resource();
+		return resource;
+	}
+}
+
+namespace pdn
+{
+	// memory resource of entities made by current thread, see memory_resource_scope.
+	// it is ::std::pmr::new_delete_resource() out of any scope.
+	inline auto current_memory_resource() noexcept -> ::std::pmr::memory_resource*
+	{
+		return detail::current_memory_resource_ref();
+	}
+
+	// makes resource current memory resource of calling thread in its lifetime,
+	// strings, lists, objects and proxies made by the thread in the scope allocate from resource
+	// when entities are configured with PDN_Macro_entity_memory_resource (see pdn_type_config.h).
+	class memory_resource_scope
+	{
+	public:
+		explicit memory_resource_scope(::std::pmr::memory_resource* resource) noexcept :
+			last{ ::std::exchange(detail::current_memory_resource_ref(), resource) } {}
+		memory_resource_scope(const memory_resource_scope&) = delete;
+		memory_resource_scope& operator=(const memory_resource_scope&) = delete;
+		~memory_resource_scope()
+		{
+			detail::current_memory_resource_ref() = last;
+		}
+	private:
+		::std::pmr::memory_resource* last{};
+	};
+
+	// polymorphic allocator whose default is current memory resource instead of default resource of ::std::pmr,
+	// copy of container allocates from current memory resource too.
+	template <typename t>
+	class resource_allocator : public ::std::pmr::polymorphic_allocator<t>
+	{
+	private:
+		using base_type = ::std::pmr::polymorphic_allocator<t>;
+	public:
+		using value_type = t;
+		resource_allocator() noexcept : base_type{ current_memory_resource() } {}
+		resource_allocator(::std::pmr::memory_resource* resource) noexcept : base_type{ resource } {}
+		resource_allocator(const resource_allocator&) = default;
+		template <typename u>
+		resource_allocator(const resource_allocator<u>& other) noexcept : base_type{ other.resource() } {}
+		resource_allocator& operator=(const resource_allocator&) = delete;
+		auto select_on_container_copy_construction() const -> resource_allocator
+		{
+			return resource_allocator{};
+		}
+		template <typename u>
+		friend bool operator==(const resource_allocator& lhs, const resource_allocator<u>& rhs) noexcept
+		{
+			return *lhs.resource() == *rhs.resource();
+		}
+	};
+}
+
+namespace pdn::detail
+{
+	// deleter of object allocated by allocate_in_resource
+	template <typename t>
+	struct resource_deleter
+	{
+		::std::pmr::memory_resource* resource{};
+		void operator()(t* p) const noexcept
+		{
+			p->~t();
+			resource->deallocate(p, sizeof(t), alignof(t));
+		}
+	};
+
+	// constructs t in current memory resource
+	template <typename t, typename... args_t>
+	auto allocate_in_resource(args_t&&... args) -> ::std::unique_ptr<t, resource_deleter<t>>
+	{
+		auto resource = current_memory_resource();
+		auto p = resource->allocate(sizeof(t), alignof(t));
+		try
+		{
+			return ::std::unique_ptr<t, resource_deleter<t>>{ ::new (p) t(::std::forward<args_t>(args)...), resource_deleter<t>{ resource } };
+		}
+		catch (...)
+		{
+			resource->deallocate(p, sizeof(t), alignof(t));
+			throw;
+		}
+	}
+}
+
+#endif
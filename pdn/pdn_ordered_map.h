@@ -1,84 +1,249 @@
 #ifndef PDN_Header_pdn_ordered_map
 #define PDN_Header_pdn_ordered_map
 
+#include <cstddef>
 #include <utility>
 #include <memory>
 #include <functional>
+#include <tuple>
+#include <iterator>
+#include <compare>
 
 #include <type_traits>
 #include <algorithm>
 #include <stdexcept>
 
-#include <deque>
+#include <vector>
+
+#include "pdn_map_slot.h"
 
 namespace pdn::type::detail
 {
+	// map keeping insertion order, entries are held in vector in order they are inserted,
+	// and found by open addressing index of their positions, so lookup and insertion take O(1) on average.
+	// entries are held in map_slot, so growing vector moves them instead of copying them,
+	// and references to values are invalidated by growing as vector does, but values held by proxy stay where they are.
+	// lookup is heterogeneous when hash_t and key_equal_t accept the argument, e.g. string_view for string keys.
+	// erasing shifts entries after it and rebuilds index, it takes O(n).
 	template <typename key_t,
 	          typename val_t,
-	          template <typename t, typename alloc> typename container_t = ::std::deque,
-	          typename alloc_t = ::std::allocator<::std::pair<const key_t, val_t>>>
-	class ordered_map : public container_t<::std::pair<const key_t, val_t>, alloc_t>
+	          typename hash_t      = ::std::hash<key_t>,
+	          typename key_equal_t = ::std::equal_to<>,
+	          typename alloc_t     = ::std::allocator<::std::pair<const key_t, val_t>>>
+	class ordered_map
 	{
-		using base_type = container_t<::std::pair<const key_t, val_t>, alloc_t>;
-		using bt = base_type;
 	public:
 		using key_type        = key_t;
 		using mapped_type     = val_t;
 		using value_type      = ::std::pair<const key_t, val_t>;
-		using size_type       = bt::size_type;
-		using difference_type = bt::difference_type;
+		using hasher          = hash_t;
+		using key_equal       = key_equal_t;
 		using allocator_type  = alloc_t;
+	private:
+		using alloc_traits    = ::std::allocator_traits<alloc_t>;
+		using slot_type       = map_slot<key_t, val_t>;
+		using entry_allocator = typename alloc_traits::template rebind_alloc<slot_type>;
+		using entries_type    = ::std::vector<slot_type, entry_allocator>;
+	public:
+		using size_type       = typename entries_type::size_type;
+		using difference_type = typename entries_type::difference_type;
 		using reference       = value_type&;
 		using const_reference = const value_type&;
-		using pointer         = ::std::allocator_traits<alloc_t>::pointer;
-		using const_pointer   = ::std::allocator_traits<alloc_t>::const_pointer;
-		using iterator        = bt::iterator;
-		using const_iterator  = bt::const_iterator;
+		using pointer         = typename alloc_traits::pointer;
+		using const_pointer   = typename alloc_traits::const_pointer;
+	private:
+		// iterates over slots of entries, and hands out their values whose keys are const
+		template <bool is_const>
+		class basic_iterator
+		{
+		public:
+			using iterator_category = ::std::random_access_iterator_tag;
+			using value_type        = ordered_map::value_type;
+			using difference_type   = ordered_map::difference_type;
+			using pointer           = ::std::conditional_t<is_const, const value_type*, value_type*>;
+			using reference         = ::std::conditional_t<is_const, const value_type&, value_type&>;
 
-		using base_type::base_type;
+			basic_iterator() = default;
+			template <bool other_const> requires (is_const && !other_const)
+			basic_iterator(const basic_iterator<other_const>& o) : slot{ o.slot } {}
 
-		auto get_base() noexcept -> base_type&
+			auto operator*()  const -> reference { return slot->value;  }
+			auto operator->() const -> pointer   { return &slot->value; }
+			auto operator[](difference_type n) const -> reference
+			{
+				return slot[n].value;
+			}
+			auto operator++() -> basic_iterator&
+			{
+				++slot;
+				return *this;
+			}
+			auto operator--() -> basic_iterator&
+			{
+				--slot;
+				return *this;
+			}
+			auto operator++(int) -> basic_iterator
+			{
+				auto result = *this;
+				++slot;
+				return result;
+			}
+			auto operator--(int) -> basic_iterator
+			{
+				auto result = *this;
+				--slot;
+				return result;
+			}
+			auto operator+=(difference_type n) -> basic_iterator&
+			{
+				slot += n;
+				return *this;
+			}
+			auto operator-=(difference_type n) -> basic_iterator&
+			{
+				slot -= n;
+				return *this;
+			}
+			friend auto operator+(basic_iterator it, difference_type n) -> basic_iterator
+			{
+				return it += n;
+			}
+			friend auto operator+(difference_type n, basic_iterator it) -> basic_iterator
+			{
+				return it += n;
+			}
+			friend auto operator-(basic_iterator it, difference_type n) -> basic_iterator
+			{
+				return it -= n;
+			}
+			friend auto operator-(const basic_iterator& lhs, const basic_iterator& rhs) -> difference_type
+			{
+				return lhs.slot - rhs.slot;
+			}
+			friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+			{
+				return lhs.slot == rhs.slot;
+			}
+			friend auto operator<=>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+			{
+				return lhs.slot <=> rhs.slot;
+			}
+		private:
+			friend class ordered_map;
+			template <bool>
+			friend class basic_iterator;
+			using slot_pointer = ::std::conditional_t<is_const, const slot_type*, slot_type*>;
+			slot_pointer slot{};
+
+			explicit basic_iterator(slot_pointer slot) noexcept : slot{ slot } {}
+		};
+	public:
+		using iterator       = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+	private:
+		struct slot
+		{
+			size_type   position; // position of entry + 1, 0 if slot is empty
+			::std::size_t hash;
+		};
+		using slot_allocator = typename alloc_traits::template rebind_alloc<slot>;
+		using index_type     = ::std::vector<slot, slot_allocator>;
+	public:
+		ordered_map() = default;
+		explicit ordered_map(const allocator_type& alloc) : entries{ entry_allocator{ alloc } }, index{ slot_allocator{ alloc } } {}
+		ordered_map(const ordered_map&) = default;
+		ordered_map(const ordered_map& o, const allocator_type& alloc) : entries{ o.entries, entry_allocator{ alloc } }, index{ o.index, slot_allocator{ alloc } } {}
+		ordered_map(ordered_map&& o) noexcept : entries{ ::std::move(o.entries) }, index{ ::std::move(o.index) }
+		{
+			o.clear();
+		}
+		ordered_map(ordered_map&& o, const allocator_type& alloc) : entries{ ::std::move(o.entries), entry_allocator{ alloc } }, index{ ::std::move(o.index), slot_allocator{ alloc } }
+		{
+			o.clear();
+		}
+		ordered_map(::std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type{}) : ordered_map{ alloc }
 		{
+			for (const auto& v : il)
+			{
+				try_emplace(v.first, v.second);
+			}
+		}
+		// allocator of this map is kept as allocator aware containers do when it is not propagated,
+		// so entries are copied or moved into it
+		ordered_map& operator=(const ordered_map& o)
+		{
+			if (this != &o)
+			{
+				auto copy = ordered_map{ o, get_allocator() };
+				entries.swap(copy.entries);
+				index.swap(copy.index);
+			}
 			return *this;
 		}
-		auto get_base() const noexcept -> const base_type&
+		ordered_map& operator=(ordered_map&& o)
 		{
+			if (this != &o)
+			{
+				auto moved = ordered_map{ ::std::move(o), get_allocator() };
+				entries.swap(moved.entries);
+				index.swap(moved.index);
+			}
 			return *this;
 		}
+		~ordered_map() = default;
 
 		auto get_allocator() const noexcept -> allocator_type
 		{
-			return bt::get_allocator();
+			return allocator_type{ entries.get_allocator() };
 		}
 
-		auto begin()        { return bt::begin();  }
-		auto end()          { return bt::end();    }
-		auto begin()  const { return bt::begin();  }
-		auto end()    const { return bt::end();    }
-		auto cbegin() const { return bt::cbegin(); }
-		auto cend()   const { return bt::cend();   }
+		auto begin()        noexcept { return iterator{ entries.data() };                        }
+		auto end()          noexcept { return iterator{ entries.data() + entries.size() };       }
+		auto begin()  const noexcept { return const_iterator{ entries.data() };                  }
+		auto end()    const noexcept { return const_iterator{ entries.data() + entries.size() }; }
+		auto cbegin() const noexcept { return begin(); }
+		auto cend()   const noexcept { return end();   }
 
-		auto empty() const { return bt::empty(); }
-		auto size()  const { return bt::size();  }
+		auto empty() const noexcept { return entries.empty(); }
+		auto size()  const noexcept { return entries.size();  }
 
 		void clear() noexcept
 		{
-			bt::clear();
+			entries.clear();
+			index.clear();
+		}
+
+		void reserve(size_type count)
+		{
+			entries.reserve(count);
+			if (capacity_of(count) > index.size())
+			{
+				rehash(capacity_of(count));
+			}
 		}
 
 		iterator erase(iterator pos)
 		{
-			return bt::erase(pos);
+			return erase(const_iterator{ pos });
 		}
 
 		iterator erase(const_iterator pos)
 		{
-			return bt::erase(pos);
+			return erase(pos, pos + 1);
 		}
 
 		iterator erase(const_iterator first, const_iterator last)
 		{
-			return bt::erase(first, last);
+			auto first_pos = static_cast<size_type>(first - cbegin());
+			auto last_pos  = static_cast<size_type>(last - cbegin());
+			if (first_pos == last_pos)
+			{
+				return begin() + first_pos;
+			}
+			entries.erase(entries.begin() + first_pos, entries.begin() + last_pos);
+			rehash(index.size());
+			return begin() + first_pos;
 		}
 
 		template <typename k_t>
@@ -114,13 +279,43 @@ namespace pdn::type::detail
 		template <typename k_t>
 		auto operator[](k_t&& k) -> mapped_type&
 		{
-			auto find_r = find(k);
-			if (find_r != cend())
+			return try_emplace(::std::forward<k_t>(k)).first->second;
+		}
+
+		// inserts value made by args at the end if k is not found, k is converted to key_type only when it is inserted
+		template <typename k_t, typename... args_t>
+		auto try_emplace(k_t&& k, args_t&&... args) -> ::std::pair<iterator, bool>
+		{
+			static_assert(::std::is_nothrow_move_constructible_v<slot_type>,
+			              "[pdn] entries of ordered_map must be nothrow move constructible, or growing copies them");
+			if (index.empty())
+			{
+				rehash(capacity_of(1));
+			}
+			auto hash = hasher{}(k);
+			if (auto found = find_slot(k, hash); index[found].position != 0)
 			{
-				return find_r->second;
+				return { begin() + (index[found].position - 1), false };
 			}
-			bt::emplace_back(::std::forward<k_t>(k), mapped_type{});
-			return bt::back().second;
+			if (capacity_of(size() + 1) > index.size())
+			{
+				rehash(capacity_of(size() + 1));
+			}
+			entries.emplace_back(::std::piecewise_construct,
+			                     ::std::forward_as_tuple(::std::forward<k_t>(k)),
+			                     ::std::forward_as_tuple(::std::forward<args_t>(args)...));
+			index[find_slot(entries.back().value.first, hash)] = slot{ size(), hash };
+			return { end() - 1, true };
+		}
+
+		auto insert(const value_type& v) -> ::std::pair<iterator, bool>
+		{
+			return try_emplace(v.first, v.second);
+		}
+
+		auto insert(value_type&& v) -> ::std::pair<iterator, bool>
+		{
+			return try_emplace(v.first, ::std::move(v.second));
 		}
 
 		template <typename k_t>
@@ -136,15 +331,84 @@ namespace pdn::type::detail
 		}
 
 		template <typename k_t>
-		auto find(const k_t& k) const
+		auto find(const k_t& k) const -> const_iterator
 		{
-			return ::std::find_if(begin(), end(), [&](const auto& v) { return v.first == k; });
+			if (index.empty())
+			{
+				return end();
+			}
+			auto position = index[find_slot(k, hasher{}(k))].position;
+			return position == 0 ? end() : begin() + (position - 1);
 		}
 
 		template <typename k_t>
-		auto find(const k_t& k)
+		auto find(const k_t& k) -> iterator
 		{
-			return ::std::find_if(begin(), end(), [&](const auto& v) { return v.first == k; });
+			auto it = ::std::as_const(*this).find(k);
+			return begin() + (it - cbegin());
+		}
+
+		// maps are equal if they hold same entries, regardless of their order as unordered_map
+		friend bool operator==(const ordered_map& lhs, const ordered_map& rhs)
+		{
+			if (lhs.size() != rhs.size())
+			{
+				return false;
+			}
+			for (const auto& [key, value] : lhs)
+			{
+				auto it = rhs.find(key);
+				if (it == rhs.end() || !(it->second == value))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	private:
+		entries_type entries{};
+		index_type   index{}; // size of index is 0 or power of 2, it is kept at most 3/4 full
+
+		static auto capacity_of(size_type count) noexcept -> size_type
+		{
+			auto capacity = size_type{ 8 };
+			while (capacity / 4 * 3 < count)
+			{
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		// slot holding k, or empty slot where k is to be put, index must not be empty
+		template <typename k_t>
+		auto find_slot(const k_t& k, ::std::size_t hash) const -> size_type
+		{
+			auto mask = index.size() - 1;
+			for (auto i = static_cast<size_type>(hash) & mask; ; i = (i + 1) & mask)
+			{
+				const auto& s = index[i];
+				if (s.position == 0 || (s.hash == hash && key_equal{}(entries[s.position - 1].value.first, k)))
+				{
+					return i;
+				}
+			}
+		}
+
+		void rehash(size_type capacity)
+		{
+			auto rebuilt = index_type(capacity, slot{}, index.get_allocator());
+			auto mask = capacity - 1;
+			for (size_type position{}; position < size(); ++position)
+			{
+				auto hash = hasher{}(entries[position].value.first);
+				auto i = static_cast<size_type>(hash) & mask;
+				while (rebuilt[i].position != 0)
+				{
+					i = (i + 1) & mask;
+				}
+				rebuilt[i] = slot{ position + 1, hash };
+			}
+			index.swap(rebuilt);
 		}
 	};
 }
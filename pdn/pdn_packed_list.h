@@ -0,0 +1,211 @@
+#ifndef PDN_Header_pdn_packed_list
+#define PDN_Header_pdn_packed_list
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "pdn_type_basic.h"
+#include "pdn_type_config.h"
+
+namespace pdn::detail
+{
+	// growable array of t, unlike std::vector<bool> it holds booleans as bool, so they are viewed by span
+	template <typename t, typename alloc_t = ::std::allocator<t>>
+	class packed_array
+	{
+	private:
+		using alloc_traits = ::std::allocator_traits<alloc_t>;
+	public:
+		auto data() const noexcept -> const t* { return items; }
+		auto size() const noexcept -> ::std::size_t { return count; }
+
+		void reserve(::std::size_t n)
+		{
+			if (n > capacity)
+			{
+				auto grown = alloc_traits::allocate(alloc, n);
+				::std::copy(items, items + count, grown);
+				release();
+				items    = grown;
+				capacity = n;
+			}
+		}
+		void push_back(t v)
+		{
+			if (count == capacity)
+			{
+				reserve(capacity ? capacity * 2 : 16);
+			}
+			items[count++] = v;
+		}
+
+		packed_array() = default;
+		packed_array(const packed_array& o) : alloc{ alloc_traits::select_on_container_copy_construction(o.alloc) }
+		{
+			assign(o);
+		}
+		packed_array(packed_array&& o) noexcept :
+			alloc{ o.alloc },
+			items{ ::std::exchange(o.items, nullptr) },
+			count{ ::std::exchange(o.count, 0) },
+			capacity{ ::std::exchange(o.capacity, 0) } {}
+		packed_array& operator=(const packed_array& o)
+		{
+			if (this != &o)
+			{
+				assign(o);
+			}
+			return *this;
+		}
+		// allocator is kept, so items are copied if o allocates from other resource
+		packed_array& operator=(packed_array&& o) noexcept(alloc_traits::is_always_equal::value)
+		{
+			if (this == &o)
+			{
+				return *this;
+			}
+			if (alloc == o.alloc)
+			{
+				release();
+				items    = ::std::exchange(o.items, nullptr);
+				count    = ::std::exchange(o.count, 0);
+				capacity = ::std::exchange(o.capacity, 0);
+			}
+			else
+			{
+				assign(o);
+			}
+			return *this;
+		}
+		~packed_array()
+		{
+			release();
+		}
+	private:
+		void assign(const packed_array& o)
+		{
+			count = 0;
+			reserve(o.count);
+			::std::copy(o.items, o.items + o.count, items);
+			count = o.count;
+		}
+		void release() noexcept
+		{
+			if (items)
+			{
+				alloc_traits::deallocate(alloc, items, capacity);
+			}
+		}
+
+		[[no_unique_address]] alloc_t alloc{};
+		t*            items{};
+		::std::size_t count{};
+		::std::size_t capacity{};
+	};
+}
+
+namespace pdn::type
+{
+	// list whose elements are all of one integral, floating point or boolean type, held as array of that type.
+	// parser makes it instead of list when PDN_Macro_pack_lists is defined (see pdn_type_config.h),
+	// its elements are viewed by as_span<T>(), and it is serialized as list of its elements.
+	class packed_list
+	{
+	public:
+		template <typename t>
+		using array = pdn::detail::packed_array<t, config::packed_allocator<t>>;
+		// same order as entity_variant
+		using storage_type = ::std::variant<
+			array<i32>, array<i64>, array<i8>, array<i16>,
+			array<u32>, array<u64>, array<u8>, array<u16>,
+			array<f32>, array<f64>,
+			array<boolean>>;
+		using size_type = ::std::size_t;
+
+		template <typename t>
+		static constexpr bool packable =
+			::std::same_as<t, i32> || ::std::same_as<t, i64> || ::std::same_as<t, i8>  || ::std::same_as<t, i16> ||
+			::std::same_as<t, u32> || ::std::same_as<t, u64> || ::std::same_as<t, u8>  || ::std::same_as<t, u16> ||
+			::std::same_as<t, f32> || ::std::same_as<t, f64> || ::std::same_as<t, boolean>;
+
+		auto size() const noexcept -> size_type
+		{
+			return ::std::visit([](const auto& a) { return a.size(); }, elements);
+		}
+		bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+		// index of type of elements in entity_variant
+		auto index() const noexcept -> ::std::size_t
+		{
+			return elements.index();
+		}
+		template <typename t>
+		bool holds() const noexcept
+		{
+			return ::std::holds_alternative<array<t>>(elements);
+		}
+		// elements, empty if they are not of type t
+		template <typename t>
+		auto as_span() const noexcept -> ::std::span<const t>
+		{
+			static_assert(packable<t>, "[pdn] only lists of integral, floating point or boolean are packed");
+			if (auto p = ::std::get_if<array<t>>(&elements))
+			{
+				return { p->data(), p->size() };
+			}
+			return {};
+		}
+		// calls f with span of elements
+		template <typename func_t>
+		auto visit(func_t&& f) const -> decltype(auto)
+		{
+			return ::std::visit([&]<typename t, typename a>(const pdn::detail::packed_array<t, a>& arr) -> decltype(auto)
+			{
+				return f(::std::span<const t>{ arr.data(), arr.size() });
+			}, elements);
+		}
+		// empty list takes type of its first element, other list holds elements of one type only
+		template <typename t>
+		void push_back(t value)
+		{
+			static_assert(packable<t>, "[pdn] only lists of integral, floating point or boolean are packed");
+			auto p = ::std::get_if<array<t>>(&elements);
+			if (p == nullptr)
+			{
+				assert(empty() && "[pdn] element of other type is pushed into packed_list");
+				p = &elements.template emplace<array<t>>();
+			}
+			p->push_back(value);
+		}
+		void reserve(size_type n)
+		{
+			::std::visit([n](auto& a) { a.reserve(n); }, elements);
+		}
+
+		friend bool operator==(const packed_list& lhs, const packed_list& rhs)
+		{
+			if (lhs.elements.index() != rhs.elements.index())
+			{
+				return false;
+			}
+			return lhs.visit([&]<typename t>(::std::span<const t> l)
+			{
+				auto r = rhs.as_span<t>();
+				return ::std::equal(l.begin(), l.end(), r.begin(), r.end());
+			});
+		}
+	private:
+		storage_type elements{};
+	};
+}
+
+#endif
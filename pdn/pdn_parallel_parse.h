@@ -0,0 +1,383 @@
+#ifndef PDN_Header_pdn_parallel_parse
+#define PDN_Header_pdn_parallel_parse
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <string_view>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <optional>
+#include <algorithm>
+
+#include "pdn_unicode_base.h"
+#include "pdn_utf_code_convert.h"
+#include "pdn_source_position.h"
+#include "pdn_source_position_recorder.h"
+#include "pdn_source_locator.h"
+#include "pdn_error_message.h"
+#include "pdn_raw_error_message.h"
+#include "pdn_raw_error_message_type.h"
+#include "pdn_error_string.h"
+#include "pdn_syntax_error_code.h"
+#include "pdn_token_code.h"
+#include "pdn_code_point_iterator.h"
+#include "pdn_lexer.h"
+#include "pdn_parser.h"
+#include "pdn_parser_utility.h"
+#include "pdn_function_package.h"
+#include "pdn_entity.h"
+#include "pdn_memory_resource.h"
+
+namespace pdn
+{
+	// option for parse_parallel
+	struct parallel_option
+	{
+		::std::size_t thread_count     = 0;          // 0 for ::std::thread::hardware_concurrency()
+		::std::size_t chunk_per_thread = 4;          // more chunks balance work of threads better
+		::std::size_t min_chunk_size   = 64 * 1024;  // in code units, source less than two chunks is parsed by calling thread
+		bool          shared_resource  = false;      // current_memory_resource() is thread safe, threads allocate from it
+	};
+}
+
+namespace pdn::detail
+{
+	// function package of code point iterator and lexer for scan_split_points, errors are counted only
+	class split_scan_package
+	{
+	public:
+		auto position() const -> source_position
+		{
+			return pos_recorder.position();
+		}
+		void update(const char32_t c)
+		{
+			pos_recorder.update(c);
+		}
+		void handle_error(const error_message&) noexcept
+		{
+			++errors;
+		}
+		static auto generate_error_message(raw_error_message) -> error_msg_string
+		{
+			return {};
+		}
+		auto error_count() const noexcept -> ::std::size_t
+		{
+			return errors;
+		}
+	private:
+		source_position_recorder pos_recorder{};
+		::std::size_t            errors{};
+	};
+
+	// where parse of source can be split, as parser is in root object expecting a declaration there
+	struct split_point
+	{
+		::std::size_t   offset{};
+		source_position position{};
+	};
+
+	// finds identifiers which follow semicolon or right bracket in root object, bodies of lists and objects are
+	// skipped by lexer, so strings, raw strings and comments are recognized as parser does.
+	// identifier is not taken if lexing of it or of the token following it makes errors,
+	// those errors are reported in different order when source is split there.
+	template <unicode::concepts::code_unit char_t, unicode::concepts::code_unit unit_t>
+	auto scan_split_points(::std::basic_string_view<unit_t> source) -> ::std::vector<split_point>
+	{
+		using enum pdn_token_code;
+
+		auto positions = ::std::vector<source_position>{};
+		auto scan_fp   = split_scan_package{};
+		lexer<char_t, split_scan_package> lex{ scan_fp };
+		auto cp_it     = make_code_point_iterator(source.data(), source.data() + source.size(), scan_fp);
+		auto token_it  = make_token_iterator(lex, cp_it, source.data() + source.size());
+		auto token_end = make_end_token_iterator(token_it);
+
+		auto is_after_end = false;                              // last token ends value or declaration
+		auto candidate    = ::std::optional<source_position>{}; // identifier waiting for the token following it
+		auto errors       = ::std::size_t{};                    // count of errors made by lexing current token
+		while (token_it != token_end)
+		{
+			const auto code = (*token_it).code;
+			if (candidate && errors == 0)
+			{
+				positions.push_back(*candidate);
+			}
+			candidate.reset();
+			if (code == identifier && is_after_end && errors == 0)
+			{
+				candidate = (*token_it).position;
+			}
+			is_after_end = code == semicolon || code == right_brackets || code == right_curly_brackets;
+			const auto errors_before = scan_fp.error_count();
+			++token_it;
+			if (code == left_brackets || code == left_curly_brackets)
+			{
+				// to [ CURPOS ...
+				token_it.skip_container(code);
+			}
+			errors = scan_fp.error_count() - errors_before;
+		}
+		if (candidate && errors == 0)
+		{
+			positions.push_back(*candidate);
+		}
+
+		auto points  = ::std::vector<split_point>{};
+		auto locator = source_locator<unit_t>{ source, 0, source_position{} };
+		points.reserve(positions.size());
+		for (const auto& pos : positions)
+		{
+			if (auto offset = locator.find(pos))
+			{
+				points.push_back(split_point{ *offset, pos });
+			}
+		}
+		return points;
+	}
+
+	// error reported by parse of chunk, with count of names declared in root object before it
+	struct chunk_error
+	{
+		error_message message;
+		::std::size_t declared{};
+	};
+
+	// part of source parsed by a thread of parse_parallel, from split point to the next one
+	template <typename char_t>
+	struct parse_chunk
+	{
+		split_point                                        start{};
+		::std::size_t                                      last{};       // offset past the last code unit
+		type::object<char_t>                               object{};
+		::std::vector<parser_utility::declaration<char_t>> declared{};
+		::std::vector<chunk_error>                         errors{};
+		::std::exception_ptr                               exception{};
+	};
+
+	// function package for parse of chunk on worker thread, position is counted from start of chunk,
+	// errors are kept in chunk and handled by function_package after all chunks are parsed.
+	// generators of function_package are called by worker threads.
+	template <typename char_t, typename function_package>
+	class chunk_package
+	{
+	public:
+		auto position() const -> source_position
+		{
+			return pos_recorder.position();
+		}
+		void update(const char32_t c)
+		{
+			pos_recorder.update(c);
+		}
+		void handle_error(const error_message& msg)
+		{
+			chunk->errors.push_back(chunk_error{ msg, chunk->declared.size() });
+		}
+		auto generate_error_message(raw_error_message raw) -> error_msg_string
+		{
+			return func_pkg->generate_error_message(::std::move(raw));
+		}
+		auto generate_constant(const unicode::u8string& iden) -> ::std::optional<entity<char_t>>
+		{
+			return func_pkg->generate_constant(iden);
+		}
+		auto generate_type(const type::string<char_t>& iden) -> type_code
+		{
+			return func_pkg->generate_type(iden);
+		}
+		auto max_nesting_depth() const -> ::std::size_t requires concepts::nesting_depth_limiter<function_package>
+		{
+			return func_pkg->max_nesting_depth();
+		}
+		chunk_package(function_package& function_pkg, parse_chunk<char_t>& c) :
+			func_pkg    { &function_pkg },
+			chunk       { &c },
+			pos_recorder{ c.start.position } {}
+	private:
+		function_package*        func_pkg{};
+		parse_chunk<char_t>*     chunk{};
+		source_position_recorder pos_recorder{};
+	};
+
+	template <typename char_t, typename unit_t, typename function_package>
+	void parse_chunk_of_source(::std::basic_string_view<unit_t> source, parse_chunk<char_t>& c, function_package& fp)
+	{
+		using chunk_pkg = chunk_package<char_t, function_package>;
+		using cp_it_t   = code_point_iterator<const unit_t*, const unit_t*, chunk_pkg>;
+
+		auto chunk_fp  = chunk_pkg{ fp, c };
+		auto first     = source.data() + c.start.offset;
+		auto last      = source.data() + c.last;
+		lexer<char_t, chunk_pkg> lex{ chunk_fp };
+		auto cp_it     = cp_it_t{ first, last, chunk_fp, c.start.offset };
+		auto token_it  = make_token_iterator(lex, cp_it, last);
+		auto token_end = make_end_token_iterator(token_it);
+		parser<char_t, chunk_pkg> par{ chunk_fp };
+		par.parse(::std::move(token_it), ::std::move(token_end), c.object, c.declared);
+	}
+
+	// splits source at split points into chunks of similar size
+	template <typename char_t, typename unit_t>
+	auto make_parse_chunks(::std::basic_string_view<unit_t> source, ::std::size_t count) -> ::std::vector<parse_chunk<char_t>>
+	{
+		auto chunks = ::std::vector<parse_chunk<char_t>>(1);
+		if (count > 1)
+		{
+			const auto chunk_size = source.size() / count;
+			for (const auto& point : scan_split_points<char_t>(source))
+			{
+				if (point.offset - chunks.back().start.offset >= chunk_size && source.size() - point.offset >= chunk_size / 2)
+				{
+					chunks.emplace_back().start = point;
+				}
+			}
+		}
+		for (::std::size_t i{}; i + 1 < chunks.size(); ++i)
+		{
+			chunks[i].last = chunks[i + 1].start.offset;
+		}
+		chunks.back().last = source.size();
+		return chunks;
+	}
+
+	// parses chunks by count threads including calling thread, entities are made in memory resource of calling thread
+	template <typename char_t, typename unit_t, typename function_package>
+	void parse_chunks(::std::basic_string_view<unit_t> source, ::std::vector<parse_chunk<char_t>>& chunks, ::std::size_t count, function_package& fp)
+	{
+		const auto resource = current_memory_resource();
+		auto next = ::std::atomic<::std::size_t>{};
+		auto work = [&]
+		{
+			auto scope = memory_resource_scope{ resource };
+			for (auto n = next++; n < chunks.size(); n = next++)
+			{
+				try
+				{
+					parse_chunk_of_source(source, chunks[n], fp);
+				}
+				catch (...)
+				{
+					chunks[n].exception = ::std::current_exception();
+				}
+			}
+		};
+		auto workers = ::std::vector<::std::thread>{};
+		try
+		{
+			for (workers.reserve(count - 1); workers.size() + 1 < count; )
+			{
+				workers.emplace_back(work);
+			}
+		}
+		catch (...)
+		{
+			// calling thread works anyway
+		}
+		work();
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	// moves entities of chunks into object in order of declaration, entity declared by former chunk is redefined.
+	// errors of chunks are handled in order, so they are same as those reported by parsing whole source.
+	template <typename char_t, typename function_package>
+	auto merge_chunks(::std::vector<parse_chunk<char_t>>& chunks, function_package& fp) -> type::object<char_t>
+	{
+		using raw_err_iden = raw_error_message_type::identifier;
+		using unicode::code_convert;
+
+		auto o = ::std::move(chunks.front().object);
+		auto redefined = ::std::vector<chunk_error>{};
+		for (auto& c : chunks)
+		{
+			if (c.exception)
+			{
+				::std::rethrow_exception(c.exception);
+			}
+		}
+		for (auto& c : chunks)
+		{
+			redefined.clear();
+			if (&c != &chunks.front())
+			{
+				for (::std::size_t i{}; i < c.declared.size(); ++i)
+				{
+					auto& decl = c.declared[i];
+					if (o.find(decl.name) != o.end())
+					{
+						auto raw = raw_error_message{ { syntax_error_code::entity_redefine }, decl.position, raw_err_iden{ code_convert<error_msg_string>(decl.name) } };
+						auto msg = fp.generate_error_message(::std::move(raw));
+						redefined.push_back(chunk_error{ error_message{ syntax_error_code::entity_redefine, decl.position, ::std::move(msg) }, i });
+					}
+					else if (auto it = c.object.find(decl.name); it != c.object.end())
+					{
+						o[::std::move(decl.name)] = ::std::move(it->second);
+					}
+				}
+			}
+			// redefinition is reported before errors made after its name is read
+			auto r = redefined.begin();
+			for (const auto& e : c.errors)
+			{
+				for (; r != redefined.end() && r->declared < e.declared; ++r)
+				{
+					fp.handle_error(r->message);
+				}
+				fp.handle_error(e.message);
+			}
+			for (; r != redefined.end(); ++r)
+			{
+				fp.handle_error(r->message);
+			}
+		}
+		return o;
+	}
+}
+
+namespace pdn
+{
+	// parses contiguous source by threads, it makes same document and errors as parse.
+	// source is split at top level declarations found by a quick scan of lexer, bodies of lists and objects are skipped
+	// in the scan, chunks between them are parsed by threads, and then entities are moved into one object in order.
+	// errors are handled by calling thread after all chunks are parsed, generators of function package are called
+	// by threads at same time (those of default_function_package are static).
+	// in memory_resource_scope of resource other than ::std::pmr::new_delete_resource(), source is parsed by calling thread
+	// unless option.shared_resource tells that the resource is thread safe.
+	// in key_table_scope with interned keys, source is parsed by calling thread too.
+	template <unicode::concepts::code_unit                  char_t,
+	          unicode::concepts::code_unit                  unit_t,
+	          concepts::function_package_for_parser<char_t> fn_pkg>
+	[[nodiscard]] auto parse_parallel(::std::basic_string_view<unit_t> source, fn_pkg& fp, parallel_option option = {}, char_t = {}) -> entity<char_t>
+	{
+		auto threads = option.thread_count != 0 ? option.thread_count : ::std::thread::hardware_concurrency();
+		threads = ::std::max<::std::size_t>(threads, 1);
+		if (current_memory_resource() != ::std::pmr::new_delete_resource() && !option.shared_resource)
+		{
+			threads = 1;
+		}
+		if (type::config::intern_object_keys && current_key_table<char_t>())
+		{
+			threads = 1; // key table is not thread safe
+		}
+		auto count = threads * ::std::max<::std::size_t>(option.chunk_per_thread, 1);
+		count = ::std::min(count, source.size() / ::std::max<::std::size_t>(option.min_chunk_size, 1));
+		auto chunks = detail::make_parse_chunks<char_t>(source, threads > 1 ? count : 1);
+		detail::parse_chunks(source, chunks, ::std::min(threads, chunks.size()), fp);
+		return make_proxy<type::object<char_t>>(detail::merge_chunks(chunks, fp));
+	}
+	template <unicode::concepts::code_unit char_t,
+	          unicode::concepts::code_unit unit_t>
+	[[nodiscard]] auto parse_parallel(::std::basic_string_view<unit_t> source, parallel_option option = {}, char_t char_tag = {}) -> entity<char_t>
+	{
+		default_function_package<char_t> fp{};
+		return parse_parallel(source, fp, option, char_tag);
+	}
+}
+
+#endif
@@ -8,15 +8,25 @@
 #include <fstream>
 #include <string>
 #include <optional>
+#include <filesystem>
+#include <istream>
+#include <system_error>
 
 #include "pdn_unicode_base.h"
 
 #include "pdn_bom_reader.h"
 #include "pdn_swap_chain.h"
+#include "pdn_async_swap_chain.h"
+#include "pdn_file_mapping.h"
 #include "pdn_code_unit_iterator.h"
 #include "pdn_code_point_iterator.h"
 #include "pdn_lexer.h"
 #include "pdn_parser.h"
+#include "pdn_sax_parser.h"
+#include "pdn_pull_reader.h"
+#include "pdn_path_filter.h"
+#include "pdn_lazy_document.h"
+#include "pdn_parallel_parse.h"
 #include "pdn_function_package.h"
 #include "pdn_entity.h"
 #include "pdn_parser_utility.h"
@@ -24,6 +34,83 @@
 namespace pdn::detail
 {
 	inline constexpr ::std::size_t default_buffer_size = 1024;
+	inline constexpr ::std::size_t auto_buffer_size    = 0;           // pick buffer size from size of file and page size
+	inline constexpr ::std::size_t max_buffer_size     = 1024 * 1024; // cap of picked buffer size
+	inline constexpr ::std::size_t small_file_size     = 128 * 1024;  // file not larger than it is read whole at once
+
+	// buffer just large enough for whole file, rounded up to pages, in range [page size, max_buffer_size]
+	inline auto adaptive_buffer_size(::std::uintmax_t file_size) noexcept -> ::std::size_t
+	{
+		const auto page_size = system_page_size();
+		const auto max_size  = max_buffer_size < page_size ? page_size : max_buffer_size / page_size * page_size;
+		if (file_size >= max_size)
+		{
+			return max_size;
+		}
+		auto pages = (static_cast<::std::size_t>(file_size) + page_size - 1) / page_size;
+		return (pages == 0 ? 1 : pages) * page_size;
+	}
+
+	// remaining bytes of seekable stream, nullopt if it is unknown
+	inline auto remaining_stream_size(::std::istream& input) -> ::std::optional<::std::uintmax_t>
+	{
+		const auto state = input.rdstate();
+		const auto pos   = input.tellg();
+		if (pos == ::std::streampos(-1))
+		{
+			input.clear(state);
+			return ::std::nullopt;
+		}
+		input.seekg(0, ::std::ios_base::end);
+		const auto end_pos = input.tellg();
+		input.clear(state);
+		input.seekg(pos);
+		if (end_pos == ::std::streampos(-1) || end_pos < pos)
+		{
+			return ::std::nullopt;
+		}
+		return static_cast<::std::uintmax_t>(end_pos - pos);
+	}
+
+	inline auto resolve_buffer_size(::std::size_t buffer_size, ::std::optional<::std::uintmax_t> source_size) noexcept -> ::std::size_t
+	{
+		if (buffer_size != auto_buffer_size)
+		{
+			return buffer_size;
+		}
+		return source_size ? adaptive_buffer_size(*source_size) : default_buffer_size;
+	}
+
+	// reads whole file by one read, nullopt if failed or file size was changed
+	inline auto read_whole_file(const ::std::filesystem::path& filename, ::std::uintmax_t file_size) -> ::std::optional<::std::string>
+	{
+		::std::ifstream source_file{};
+		source_file.rdbuf()->pubsetbuf(nullptr, 0); // unbuffered, read into content directly
+		source_file.open(filename, ::std::ios::in | ::std::ios::binary);
+		if (!source_file.is_open())
+		{
+			return ::std::nullopt;
+		}
+		::std::string content(static_cast<::std::size_t>(file_size) + 1, '\0'); // one more byte for detecting growth of file
+		source_file.read(content.data(), static_cast<::std::streamsize>(content.size()));
+		if (source_file.bad() || static_cast<::std::uintmax_t>(source_file.gcount()) != file_size)
+		{
+			return ::std::nullopt;
+		}
+		content.resize(static_cast<::std::size_t>(file_size));
+		return content;
+	}
+}
+
+namespace pdn
+{
+	// option for parsing file stream by async_swap_chain,
+	// worker thread reads ahead into ring of buffer_count buffers while lexer consumes current one.
+	struct read_ahead
+	{
+		::std::size_t buffer_size  = 64 * 1024;
+		::std::size_t buffer_count = 4;
+	};
 }
 
 namespace pdn::inline utf_tag
@@ -105,17 +192,39 @@ namespace pdn
 		default_function_package<char_t> fp{};
 		return parse(sv, fp, fp, fp, char_tag);
 	}
+}
+
+namespace pdn::detail
+{
+	// result of parse_units(begin, end), which parses code units in [begin, end)
+	template <typename parse_units_t>
+	using parse_units_result_t = ::std::invoke_result_t<parse_units_t&, const unicode::u8char_t*, const unicode::u8char_t*>;
+
+	// for bytes of known encoding
+	template <typename it_t, typename parse_units_t>
+	[[nodiscard]] auto read_encoded_bytes(unicode::encode_type enc,
+	                                      it_t                 begin,
+	                                      it_t                 end,
+	                                      parse_units_t&&      parse_units) -> ::std::optional<parse_units_result_t<parse_units_t>>
+	{
+		using enum unicode::encode_type;
+
+		switch (enc)
+		{
+		case utf8:     return parse_units(make_code_unit_iterator<utf8>    (begin, end), end);
+		case utf16_le: return parse_units(make_code_unit_iterator<utf16_le>(begin, end), end);
+		case utf16_be: return parse_units(make_code_unit_iterator<utf16_be>(begin, end), end);
+		case utf32_le: return parse_units(make_code_unit_iterator<utf32_le>(begin, end), end);
+		case utf32_be: return parse_units(make_code_unit_iterator<utf32_be>(begin, end), end);
+		default:       assert(0 && "[pdn] inner error in pdn::parse: unknown bom_type"); // unreachable
+		}
+		return ::std::nullopt;
+	}
 	// for file stream
-	template <unicode::concepts::code_unit                       char_t,
-	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
-	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
-	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
-	[[nodiscard]] auto parse(::std::ifstream&   source_file,
-	                         fn_pkg_for_cp_it&  cp_it_fp,
-	                         fn_pkg_for_lexer&  lex_fp,
-	                         fn_pkg_for_parser& par_fp,
-	                         char_t             char_tag = {},
-	                         ::std::size_t      buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	template <typename parse_units_t>
+	[[nodiscard]] auto read_stream(::std::ifstream& source_file,
+	                               ::std::size_t    buffer_size,
+	                               parse_units_t&&  parse_units) -> ::std::optional<parse_units_result_t<parse_units_t>>
 	{
 		if (!source_file.is_open() || source_file.bad())
 		{
@@ -123,29 +232,150 @@ namespace pdn
 		}
 		auto bom_t = unicode::read_bom(source_file);
 		auto enc   = unicode::to_encode_type(bom_t);
+		if (buffer_size == auto_buffer_size)
+		{
+			buffer_size = resolve_buffer_size(buffer_size, remaining_stream_size(source_file));
+		}
 		auto sw    = make_swap_chain(source_file, buffer_size);
-		using enum unicode::encode_type;
-
-		switch (enc)
+		return read_encoded_bytes(enc, sw.current(), sw.end(), parse_units);
+	}
+	// for file stream, reads ahead by worker thread
+	template <typename parse_units_t>
+	[[nodiscard]] auto read_stream(::std::ifstream& source_file,
+	                               read_ahead       option,
+	                               parse_units_t&&  parse_units) -> ::std::optional<parse_units_result_t<parse_units_t>>
+	{
+		if (!source_file.is_open() || source_file.bad())
 		{
-		case utf8:     return parse(make_code_unit_iterator<utf8>    (sw.current(), sw.end()), sw.end(), cp_it_fp, lex_fp, par_fp, char_tag);
-		case utf16_le: return parse(make_code_unit_iterator<utf16_le>(sw.current(), sw.end()), sw.end(), cp_it_fp, lex_fp, par_fp, char_tag);
-		case utf16_be: return parse(make_code_unit_iterator<utf16_be>(sw.current(), sw.end()), sw.end(), cp_it_fp, lex_fp, par_fp, char_tag);
-		case utf32_le: return parse(make_code_unit_iterator<utf32_le>(sw.current(), sw.end()), sw.end(), cp_it_fp, lex_fp, par_fp, char_tag);
-		case utf32_be: return parse(make_code_unit_iterator<utf32_be>(sw.current(), sw.end()), sw.end(), cp_it_fp, lex_fp, par_fp, char_tag);
-		default:       assert(0 && "[pdn] inner error in pdn::parse: unknown bom_type"); // unreachable
+			return ::std::nullopt;
 		}
-		return ::std::nullopt;
+		auto bom_t = unicode::read_bom(source_file);
+		auto enc   = unicode::to_encode_type(bom_t);
+		auto sw    = make_async_swap_chain(source_file, option.buffer_size, option.buffer_count);
+		return read_encoded_bytes(enc, sw.current(), sw.end(), parse_units);
+	}
+	// for contiguous bytes (such as memory mapped file), code units are read by raw pointer
+	// utf-8 bytes are code units already, so they are decoded in place without code unit iterator
+	template <typename parse_units_t>
+	[[nodiscard]] auto read_bytes(const char*     begin,
+	                              const char*     end,
+	                              parse_units_t&& parse_units) -> ::std::optional<parse_units_result_t<parse_units_t>>
+	{
+		auto bom_t = unicode::read_bom(begin, end);
+		auto enc   = unicode::to_encode_type(bom_t);
+		if (enc == unicode::encode_type::utf8)
+		{
+			using u8_pointer = const unicode::u8char_t*;
+			return parse_units(reinterpret_cast<u8_pointer>(begin), reinterpret_cast<u8_pointer>(end));
+		}
+		return read_encoded_bytes(enc, begin, end, parse_units);
+	}
+	// for filename
+	// with auto_buffer_size, small file is read whole at once, large file is mapped into memory if possible,
+	// otherwise it is read by file stream of buffer picked from size of file.
+	// other buffer_size reads file by file stream of that buffer size only.
+	template <typename parse_units_t>
+	[[nodiscard]] auto read_file(const ::std::filesystem::path& filename,
+	                             ::std::size_t                  buffer_size,
+	                             parse_units_t&&                parse_units) -> ::std::optional<parse_units_result_t<parse_units_t>>
+	{
+		if (buffer_size != auto_buffer_size)
+		{
+			::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
+			return read_stream(source_file, buffer_size, parse_units);
+		}
+		::std::error_code ec{};
+		const auto file_size = ::std::filesystem::file_size(filename, ec);
+		const auto size_opt  = ec ? ::std::nullopt : ::std::optional<::std::uintmax_t>{ file_size };
+		if (size_opt && *size_opt <= small_file_size)
+		{
+			if (auto content = read_whole_file(filename, *size_opt))
+			{
+				return read_bytes(content->data(), content->data() + content->size(), parse_units);
+			}
+		}
+		if (file_mapping source_map{ filename })
+		{
+			return read_bytes(source_map.begin(), source_map.end(), parse_units);
+		}
+		::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
+		return read_stream(source_file, resolve_buffer_size(buffer_size, size_opt), parse_units);
+	}
+
+	// parse_units for parser
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	auto make_units_parser(fn_pkg_for_cp_it&  cp_it_fp,
+	                       fn_pkg_for_lexer&  lex_fp,
+	                       fn_pkg_for_parser& par_fp,
+	                       char_t             char_tag)
+	{
+		return [&cp_it_fp, &lex_fp, &par_fp, char_tag](auto begin, auto end) -> entity<char_t>
+		{
+			return parse(begin, end, cp_it_fp, lex_fp, par_fp, char_tag);
+		};
+	}
+}
+
+namespace pdn
+{
+	// buffer_size of file stream and filename overloads defaults to detail::auto_buffer_size (0),
+	// which picks buffer size from size of file, and lets filename overloads read small file whole or map large file.
+	// 0 is not taken as size of buffer, so it is never passed to swap_chain.
+	// other buffer_size reads by file stream of that size, filename overloads do not map file then.
+
+	// for file stream
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(::std::ifstream&   source_file,
+	                         fn_pkg_for_cp_it&  cp_it_fp,
+	                         fn_pkg_for_lexer&  lex_fp,
+	                         fn_pkg_for_parser& par_fp,
+	                         char_t             char_tag = {},
+	                         ::std::size_t      buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_stream(source_file, buffer_size, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
 	}
 	// for file stream
 	template <unicode::concepts::code_unit char_t>
 	[[nodiscard]] auto parse(::std::ifstream& source_file,
 	                                char_t    char_tag = {},
-	                         ::std::size_t    buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t    buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
 		default_function_package<char_t> fp{};
 		return parse(source_file, fp, fp, fp, char_tag, buffer_size);
 	}
+	// for file stream, reads ahead by worker thread
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(::std::ifstream&   source_file,
+	                         fn_pkg_for_cp_it&  cp_it_fp,
+	                         fn_pkg_for_lexer&  lex_fp,
+	                         fn_pkg_for_parser& par_fp,
+	                         char_t             char_tag,
+	                         read_ahead         option) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_stream(source_file, option, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
+	}
+	// for file stream, reads ahead by worker thread
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(::std::ifstream& source_file,
+	                         char_t           char_tag,
+	                         read_ahead       option) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(source_file, fp, fp, fp, char_tag, option);
+	}
+}
+
+namespace pdn
+{
 	// for filename
 	template <unicode::concepts::code_unit                       char_t,
 	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
@@ -156,16 +386,15 @@ namespace pdn
 	                         fn_pkg_for_lexer&    lex_fp,
 	                         fn_pkg_for_parser&   par_fp,
 	                         char_t               char_tag = {},
-	                         ::std::size_t        buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t        buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
-		::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
-		return parse(source_file, cp_it_fp, lex_fp, par_fp, char_tag, buffer_size);
+		return detail::read_file(filename, buffer_size, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
 	}
 	// for filename
 	template <unicode::concepts::code_unit char_t>
 	[[nodiscard]] auto parse(const ::std::string& filename,
 	                         char_t               char_tag = {},
-	                         ::std::size_t        buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t        buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
 		default_function_package<char_t> fp{};
 		return parse(filename, fp, fp, fp, char_tag, buffer_size);
@@ -180,16 +409,15 @@ namespace pdn
 	                         fn_pkg_for_lexer&    lex_fp,
 	                         fn_pkg_for_parser&   par_fp,
 	                         char_t               char_tag = {},
-	                         ::std::size_t        buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t        buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
-		::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
-		return parse(source_file, cp_it_fp, lex_fp, par_fp, char_tag, buffer_size);
+		return detail::read_file(filename, buffer_size, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
 	}
 	// for filename
 	template <unicode::concepts::code_unit char_t>
 	[[nodiscard]] auto parse(const char* const filename,
 	                         char_t            char_tag = {},
-	                         ::std::size_t     buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t     buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
 		default_function_package<char_t> fp{};
 		return parse(filename, fp, fp, fp, char_tag, buffer_size);
@@ -204,16 +432,15 @@ namespace pdn
 	                         fn_pkg_for_lexer&     lex_fp,
 	                         fn_pkg_for_parser&    par_fp,
 	                         char_t                char_tag = {},
-	                         ::std::size_t         buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t         buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
-		::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
-		return parse(source_file, cp_it_fp, lex_fp, par_fp, char_tag, buffer_size);
+		return detail::read_file(filename, buffer_size, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
 	}
 	// for filename
 	template <unicode::concepts::code_unit char_t>
 	[[nodiscard]] auto parse(const ::std::wstring& filename,
 	                         char_t                char_tag = {},
-	                         ::std::size_t         buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t         buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
 		default_function_package<char_t> fp{};
 		return parse(filename, fp, fp, fp, char_tag, buffer_size);
@@ -228,20 +455,466 @@ namespace pdn
 	                         fn_pkg_for_lexer&     lex_fp,
 	                         fn_pkg_for_parser&    par_fp,
 	                         char_t                char_tag = {},
-	                         ::std::size_t         buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t         buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
-		::std::ifstream source_file(filename, ::std::ios::in | ::std::ios::binary);
-		return parse(source_file, cp_it_fp, lex_fp, par_fp, char_tag, buffer_size);
+		return detail::read_file(filename, buffer_size, detail::make_units_parser(cp_it_fp, lex_fp, par_fp, char_tag));
 	}
 	// for filename
 	template <unicode::concepts::code_unit char_t>
 	[[nodiscard]] auto parse(const wchar_t* const  filename,
 	                         char_t                char_tag = {},
-	                         ::std::size_t         buffer_size = detail::default_buffer_size) -> ::std::optional<entity<char_t>>
+	                         ::std::size_t         buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
 	{
 		default_function_package<char_t> fp{};
 		return parse(filename, fp, fp, fp, char_tag, buffer_size);
 	}
 }
 
+namespace pdn
+{
+	// filtered by paths, for token iterator
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::token_iterator<char_t>              it_t,
+	          concepts::function_package_for_parser<char_t> fn_pkg>
+	[[nodiscard]] auto parse(it_t begin, auto end, fn_pkg& fp, const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		parser<char_t, fn_pkg> par{ fp };
+		return par.parse(begin, end, paths);
+	}
+	// filtered by paths, for token iterator
+	template <unicode::concepts::code_unit     char_t,
+	          concepts::token_iterator<char_t> it_t>
+	[[nodiscard]] auto parse(it_t begin, auto end, const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		default_function_package<char_t> fp{};
+		return parse(::std::move(begin), ::std::move(end), fp, paths);
+	}
+	// filtered by paths, for code_unit iterator
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_iterator                   it_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(it_t                       begin,
+	                         auto                       end,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		lexer<char_t, fn_pkg_for_lexer> lex{ lex_fp };
+		auto cp_it     = make_code_point_iterator(begin, end, cp_it_fp);
+		auto token_it  = make_token_iterator(lex, cp_it, end);
+		auto token_end = make_end_token_iterator(token_it);
+		return parse(::std::move(token_it), ::std::move(token_end), par_fp, paths);
+	}
+	// filtered by paths, for code_unit iterator
+	template <unicode::concepts::code_unit     char_t,
+	          concepts::utf_code_unit_iterator it_t>
+	[[nodiscard]] auto parse(it_t begin, auto end, const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		default_function_package<char_t> fp{};
+		return parse(::std::move(begin), ::std::move(end), fp, fp, fp, paths);
+	}
+	// filtered by paths, for utf_code_unit_string_view
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_string_view                str_view_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(str_view_t                 sv,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		return parse(::std::cbegin(sv), ::std::cend(sv), cp_it_fp, lex_fp, par_fp, paths);
+	}
+	// filtered by paths, for utf_code_unit_string_view
+	template <unicode::concepts::code_unit        char_t,
+	          concepts::utf_code_unit_string_view str_view_t>
+	[[nodiscard]] auto parse(str_view_t sv, const path_filter<char_t>& paths) -> entity<char_t>
+	{
+		default_function_package<char_t> fp{};
+		return parse(sv, fp, fp, fp, paths);
+	}
+}
+
+namespace pdn::detail
+{
+	// parse_units for parser filtered by paths
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	auto make_units_filtered_parser(fn_pkg_for_cp_it&          cp_it_fp,
+	                                fn_pkg_for_lexer&          lex_fp,
+	                                fn_pkg_for_parser&         par_fp,
+	                                const path_filter<char_t>& paths)
+	{
+		return [&cp_it_fp, &lex_fp, &par_fp, &paths](auto begin, auto end) -> entity<char_t>
+		{
+			return parse(begin, end, cp_it_fp, lex_fp, par_fp, paths);
+		};
+	}
+}
+
+namespace pdn
+{
+	// filtered by paths, for file stream
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(::std::ifstream&           source_file,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_stream(source_file, buffer_size, detail::make_units_filtered_parser(cp_it_fp, lex_fp, par_fp, paths));
+	}
+	// filtered by paths, for file stream
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(::std::ifstream&           source_file,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(source_file, fp, fp, fp, paths, buffer_size);
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(const ::std::string&       filename,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_filtered_parser(cp_it_fp, lex_fp, par_fp, paths));
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(const ::std::string&       filename,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(filename, fp, fp, fp, paths, buffer_size);
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(const char* const          filename,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_filtered_parser(cp_it_fp, lex_fp, par_fp, paths));
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(const char* const          filename,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(filename, fp, fp, fp, paths, buffer_size);
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(const ::std::wstring&      filename,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_filtered_parser(cp_it_fp, lex_fp, par_fp, paths));
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(const ::std::wstring&      filename,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(filename, fp, fp, fp, paths, buffer_size);
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	[[nodiscard]] auto parse(const wchar_t* const       filename,
+	                         fn_pkg_for_cp_it&          cp_it_fp,
+	                         fn_pkg_for_lexer&          lex_fp,
+	                         fn_pkg_for_parser&         par_fp,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_filtered_parser(cp_it_fp, lex_fp, par_fp, paths));
+	}
+	// filtered by paths, for filename
+	template <unicode::concepts::code_unit char_t>
+	[[nodiscard]] auto parse(const wchar_t* const       filename,
+	                         const path_filter<char_t>& paths,
+	                         ::std::size_t              buffer_size = detail::auto_buffer_size) -> ::std::optional<entity<char_t>>
+	{
+		default_function_package<char_t> fp{};
+		return parse(filename, fp, fp, fp, paths, buffer_size);
+	}
+}
+
+namespace pdn
+{
+	// sax, for token iterator
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::token_iterator<char_t>              it_t,
+	          concepts::sax_handler<char_t>                 handler_t,
+	          concepts::function_package_for_parser<char_t> fn_pkg>
+	void parse_sax(it_t begin, auto end, handler_t& handler, fn_pkg& fp, char_t = {})
+	{
+		sax_parser<char_t, fn_pkg, handler_t> par{ fp, handler };
+		par.parse(begin, end);
+	}
+	// sax, for token iterator
+	template <unicode::concepts::code_unit     char_t,
+	          concepts::token_iterator<char_t> it_t,
+	          concepts::sax_handler<char_t>    handler_t>
+	void parse_sax(it_t begin, auto end, handler_t& handler, char_t char_tag = {})
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		parse_sax(::std::move(begin), ::std::move(end), handler, fp, char_tag);
+	}
+	// sax, for code_unit iterator
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_iterator                   it_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	void parse_sax(it_t               begin,
+	               auto               end,
+	               handler_t&         handler,
+	               fn_pkg_for_cp_it&  cp_it_fp,
+	               fn_pkg_for_lexer&  lex_fp,
+	               fn_pkg_for_parser& par_fp,
+	               char_t             char_tag = {})
+	{
+		lexer<char_t, fn_pkg_for_lexer> lex{ lex_fp };
+		auto cp_it     = make_code_point_iterator(begin, end, cp_it_fp);
+		auto token_it  = make_token_iterator(lex, cp_it, end);
+		auto token_end = make_end_token_iterator(token_it);
+		parse_sax(::std::move(token_it), ::std::move(token_end), handler, par_fp, char_tag);
+	}
+	// sax, for code_unit iterator
+	template <unicode::concepts::code_unit     char_t,
+	          concepts::utf_code_unit_iterator it_t,
+	          concepts::sax_handler<char_t>    handler_t>
+	void parse_sax(it_t begin, auto end, handler_t& handler, char_t char_tag = {})
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		parse_sax(::std::move(begin), ::std::move(end), handler, fp, fp, fp, char_tag);
+	}
+	// sax, for utf_code_unit_string_view
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_string_view                str_view_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	void parse_sax(str_view_t         sv,
+	               handler_t&         handler,
+	               fn_pkg_for_cp_it&  cp_it_fp,
+	               fn_pkg_for_lexer&  lex_fp,
+	               fn_pkg_for_parser& par_fp,
+	               char_t             char_tag = {})
+	{
+		parse_sax(::std::cbegin(sv), ::std::cend(sv), handler, cp_it_fp, lex_fp, par_fp, char_tag);
+	}
+	// sax, for utf_code_unit_string_view
+	template <unicode::concepts::code_unit        char_t,
+	          concepts::utf_code_unit_string_view str_view_t,
+	          concepts::sax_handler<char_t>       handler_t>
+	void parse_sax(str_view_t sv, handler_t& handler, char_t char_tag = {})
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		parse_sax(sv, handler, fp, fp, fp, char_tag);
+	}
+}
+
+namespace pdn::detail
+{
+	// parse_units for sax_parser, result is true when source was read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	auto make_units_sax_parser(handler_t&         handler,
+	                           fn_pkg_for_cp_it&  cp_it_fp,
+	                           fn_pkg_for_lexer&  lex_fp,
+	                           fn_pkg_for_parser& par_fp,
+	                           char_t             char_tag)
+	{
+		return [&handler, &cp_it_fp, &lex_fp, &par_fp, char_tag](auto begin, auto end) -> bool
+		{
+			parse_sax(begin, end, handler, cp_it_fp, lex_fp, par_fp, char_tag);
+			return true;
+		};
+	}
+}
+
+namespace pdn
+{
+	// sax, for file stream, returns false if file stream cannot be read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	bool parse_sax(::std::ifstream&   source_file,
+	               handler_t&         handler,
+	               fn_pkg_for_cp_it&  cp_it_fp,
+	               fn_pkg_for_lexer&  lex_fp,
+	               fn_pkg_for_parser& par_fp,
+	               char_t             char_tag = {},
+	               ::std::size_t      buffer_size = detail::auto_buffer_size)
+	{
+		return detail::read_stream(source_file, buffer_size, detail::make_units_sax_parser(handler, cp_it_fp, lex_fp, par_fp, char_tag)).has_value();
+	}
+	// sax, for file stream, returns false if file stream cannot be read
+	template <unicode::concepts::code_unit  char_t,
+	          concepts::sax_handler<char_t> handler_t>
+	bool parse_sax(::std::ifstream& source_file,
+	               handler_t&       handler,
+	               char_t           char_tag = {},
+	               ::std::size_t    buffer_size = detail::auto_buffer_size)
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		return parse_sax(source_file, handler, fp, fp, fp, char_tag, buffer_size);
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	bool parse_sax(const ::std::string&  filename,
+	               handler_t&            handler,
+	               fn_pkg_for_cp_it&     cp_it_fp,
+	               fn_pkg_for_lexer&     lex_fp,
+	               fn_pkg_for_parser&    par_fp,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_sax_parser(handler, cp_it_fp, lex_fp, par_fp, char_tag)).has_value();
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit  char_t,
+	          concepts::sax_handler<char_t> handler_t>
+	bool parse_sax(const ::std::string&  filename,
+	               handler_t&            handler,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		return parse_sax(filename, handler, fp, fp, fp, char_tag, buffer_size);
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	bool parse_sax(const char* const     filename,
+	               handler_t&            handler,
+	               fn_pkg_for_cp_it&     cp_it_fp,
+	               fn_pkg_for_lexer&     lex_fp,
+	               fn_pkg_for_parser&    par_fp,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_sax_parser(handler, cp_it_fp, lex_fp, par_fp, char_tag)).has_value();
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit  char_t,
+	          concepts::sax_handler<char_t> handler_t>
+	bool parse_sax(const char* const     filename,
+	               handler_t&            handler,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		return parse_sax(filename, handler, fp, fp, fp, char_tag, buffer_size);
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	bool parse_sax(const ::std::wstring& filename,
+	               handler_t&            handler,
+	               fn_pkg_for_cp_it&     cp_it_fp,
+	               fn_pkg_for_lexer&     lex_fp,
+	               fn_pkg_for_parser&    par_fp,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_sax_parser(handler, cp_it_fp, lex_fp, par_fp, char_tag)).has_value();
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit  char_t,
+	          concepts::sax_handler<char_t> handler_t>
+	bool parse_sax(const ::std::wstring& filename,
+	               handler_t&            handler,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		return parse_sax(filename, handler, fp, fp, fp, char_tag, buffer_size);
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::sax_handler<char_t>                      handler_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	bool parse_sax(const wchar_t* const  filename,
+	               handler_t&            handler,
+	               fn_pkg_for_cp_it&     cp_it_fp,
+	               fn_pkg_for_lexer&     lex_fp,
+	               fn_pkg_for_parser&    par_fp,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		return detail::read_file(filename, buffer_size, detail::make_units_sax_parser(handler, cp_it_fp, lex_fp, par_fp, char_tag)).has_value();
+	}
+	// sax, for filename, returns false if file cannot be read
+	template <unicode::concepts::code_unit  char_t,
+	          concepts::sax_handler<char_t> handler_t>
+	bool parse_sax(const wchar_t* const  filename,
+	               handler_t&            handler,
+	               char_t                char_tag = {},
+	               ::std::size_t         buffer_size = detail::auto_buffer_size)
+	{
+		sax_function_package<char_t, handler_t> fp{ handler };
+		return parse_sax(filename, handler, fp, fp, fp, char_tag, buffer_size);
+	}
+}
+
 #endif
@@ -8,6 +8,9 @@
 #include <limits>
 #include <concepts>
 #include <type_traits>
+#include <cstddef>
+#include <vector>
+#include <optional>
 
 #include "pdn_unicode_base.h"
 #include "pdn_utf_code_convert.h"
@@ -33,9 +36,11 @@
 #include "pdn_error_message_generator_concept.h"
 #include "pdn_type_generator_concept.h"
 #include "pdn_constant_generator_concept.h"
+#include "pdn_sax_handler_concept.h"
 
 #include "pdn_make_slashes_string.h"
 #include "pdn_parser_utility.h"
+#include "pdn_path_filter.h"
 
 namespace pdn::concepts
 {
@@ -49,19 +54,71 @@ namespace pdn::concepts
 
 namespace pdn
 {
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::function_package_for_parser<char_t> function_package,
+	          concepts::sax_handler<char_t>                 handler_t>
+	class sax_parser;
+
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::function_package_for_parser<char_t> function_package,
+	          typename                                      token_it_t,
+	          typename                                      token_end_t>
+	class pull_reader;
+
 	template <unicode::concepts::code_unit char_t, concepts::function_package_for_parser<char_t> function_package>
 	class parser
 	{
+		// sax_parser and pull_reader share grammar of values (unary operation, casting, constants) with parser
+		template <unicode::concepts::code_unit                      sax_char_t,
+		          concepts::function_package_for_parser<sax_char_t> sax_function_package,
+		          concepts::sax_handler<sax_char_t>                 sax_handler_t>
+		friend class sax_parser;
+		template <unicode::concepts::code_unit                      pull_char_t,
+		          concepts::function_package_for_parser<pull_char_t> pull_function_package,
+		          typename                                           pull_token_it_t,
+		          typename                                           pull_token_end_t>
+		friend class pull_reader;
 	public:
 		using char_type = char_t;
 		using entity_type = entity<char_type>;
+		using lazy_container = parser_utility::lazy_container;
+		using declaration    = parser_utility::declaration<char_t>;
 	private:
 		using syn_ec = syntax_error_code;
+		enum class value_use : unsigned char
+		{
+			named,     // value of named entity in current object
+			element,   // element of current list
+			discarded, // redefined entity or expression without name, it is parsed for errors only
+			expanded,  // list or object parsed by parse_lazy_container
+		};
+		using selection = typename path_filter<char_t>::selection;
+		// where parsed value goes, and the type it is casted to
+		struct value_target
+		{
+			value_use             use{};
+			type::string<char_t>  name{};
+			type_code             type_c{ type_code::unknown };
+			source_position       type_pos{};
+			selection             selected{}; // content of value selected by path_filter
+			bool                  skipped{};  // value is not selected by path_filter, its tokens are skipped
+		};
+		// opened list or object
+		struct frame
+		{
+			entity_type                  container{};
+			type_code                    container_c{};
+			source_position              open_pos{};
+			parser_utility::unary_record unary_rec{ false };
+			value_target                 target{};
+			bool                         with_comma{ true }; // for list
+			::std::size_t                element_count{};    // for list filtered by path_filter
+		};
 	public:
 		void parse(concepts::token_iterator<char_t> auto begin, auto end, type::object<char_t>& o)
 		{
 			using enum pdn_token_code;
-			parse_start(begin, end, o);
+			parse_start(begin, end, o, nullptr);
 			assert(tk.code == eof && "parse terminated");
 		}
 		auto parse(concepts::token_iterator<char_t> auto begin, auto end) -> entity_type
@@ -70,74 +127,204 @@ namespace pdn
 			parse(begin, end, o);
 			return make_proxy<type::object<char_t>>(::std::move(o));
 		}
+		// only entities selected by paths are made, unselected lists and objects are skipped,
+		// errors in skipped tokens are not reported, so are redefinitions of unselected entities.
+		void parse(concepts::token_iterator<char_t> auto begin, auto end, type::object<char_t>& o, const path_filter<char_t>& paths)
+		{
+			using enum pdn_token_code;
+			parse_start(begin, end, o, &paths);
+			assert(tk.code == eof && "parse terminated");
+		}
+		auto parse(concepts::token_iterator<char_t> auto begin, auto end, const path_filter<char_t>& paths) -> entity_type
+		{
+			auto o = type::object<char_t>{};
+			parse(begin, end, o, paths);
+			return make_proxy<type::object<char_t>>(::std::move(o));
+		}
+		// names of entities declared in o are recorded in order of declaration, except redefined ones.
+		void parse(concepts::token_iterator<char_t> auto begin, auto end, type::object<char_t>& o, ::std::vector<declaration>& declared)
+		{
+			using enum pdn_token_code;
+			parse_start(begin, end, o, nullptr, nullptr, &declared);
+			assert(tk.code == eof && "parse terminated");
+		}
+		// lists and objects of document are made empty and recorded to pending without being parsed,
+		// their bodies are parsed later by parse_lazy_container, errors in bodies are not reported until then.
+		void parse_lazy(concepts::token_iterator<char_t> auto begin, auto end, type::object<char_t>& o, ::std::vector<lazy_container>& pending)
+		{
+			using enum pdn_token_code;
+			parse_start(begin, end, o, nullptr, &pending);
+			assert(tk.code == eof && "parse terminated");
+		}
+		// parses list or object recorded by lazy parsing into container, tokens follow its left bracket opening,
+		// lists and objects in its body are recorded to pending in turn.
+		void parse_lazy_container(token<char_t>                         opening,
+		                          concepts::token_iterator<char_t> auto begin,
+		                          auto                                  end,
+		                          entity_type&                          container,
+		                          ::std::size_t                         depth,
+		                          ::std::vector<lazy_container>&        pending)
+		{
+			using enum pdn_token_code;
+			frames.clear();
+			root_object     = nullptr;
+			filter          = nullptr;
+			declared        = nullptr;
+			lazy_pending    = &pending;
+			lazy_depth      = 1;
+			lazy_base_depth = depth;
+			expanded        = &container;
+			tk              = ::std::move(opening);
+			assert((tk.code == left_brackets || tk.code == left_curly_brackets) && "lazy container is not list or object");
+			parse_expr(begin, end, value_target{ value_use::expanded });
+			while (!frames.empty())
+			{
+				parse_step(begin, end);
+			}
+			expanded = nullptr;
+		}
 		explicit parser(function_package& function_pkg) : func_pkg{ &function_pkg } {}
 	private:
-		void parse_start(auto& begin, auto end, type::object<char_t>& o)
+		// lists and objects are parsed by loop with stack of opened containers instead of recursion,
+		// so nesting of document is limited by max_nesting_depth() but not by size of call stack.
+		// the stack is kept for next parse.
+		void parse_start(auto&                          begin,
+		                 auto                           end,
+		                 type::object<char_t>&          o,
+		                 const path_filter<char_t>*     paths,
+		                 ::std::vector<lazy_container>* pending      = nullptr,
+		                 ::std::vector<declaration>*    declarations = nullptr)
+		{
+			using enum pdn_token_code;
+
+			frames.clear();
+			root_object     = &o;
+			filter          = paths;
+			declared        = declarations;
+			lazy_pending    = pending;
+			lazy_depth      = 0;
+			lazy_base_depth = 0;
+			if (filter)
+			{
+				root_selection = filter->root();
+			}
+			for (update_token(begin, end); !frames.empty() || tk.code != eof; )
+			{
+				parse_step(begin, end);
+			}
+		}
+
+		// processes current token in innermost opened container (root object if none)
+		void parse_step(auto& begin, auto end)
 		{
 			using enum pdn_token_code;
-			using err_ms = error_msg_string;
-			using unicode::code_convert;
 			using parser_utility::is_expr_first;
+			using parser_utility::is_list_element_first;
+			using parser_utility::to_raw_error_token;
 
-			for (update_token(begin, end); tk.code != eof; )
+			if (frames.empty() || frames.back().container_c == type_code::object)
 			{
 				if (tk.code == identifier)
 				{
-					using string_pr = proxy<type::string<char_t>>;
-					auto iden_p = ::std::get<string_pr>(::std::move(tk.value));
-					if (auto it = o.find(*iden_p); it == o.end())
-					{
-						o[::std::move(*iden_p)] = parse_decl(begin, end);
-					}
-					else
-					{
-						using raw_err_iden = raw_error_message_type::identifier;
-						post_err(tk.position, syn_ec::entity_redefine, raw_err_iden{ code_convert<err_ms>(*iden_p) });
-						parse_decl(begin, end);
-					}
+					parse_decl(begin, end, current_object());
+				}
+				else if (tk.code == semicolon)
+				{
+					update_token(begin, end);
+				}
+				else if (is_expr_first(tk.code))
+				{
+					post_err(tk.position, syn_ec::expect_entity_name, to_raw_error_token(tk));
+					parse_expr(begin, end, value_target{ value_use::discarded });
+				}
+				else if (!frames.empty() && tk.code == right_curly_brackets)
+				{
+					// to ... { ... } CURRPOS
+					update_token(begin, end);
+					close_container(begin, end);
+				}
+				else if (tk.code == eof)
+				{
+					post_err(frames.back().open_pos, syn_ec::missing_right_curly_brackets, {});
+					close_container(begin, end);
 				}
 				else
 				{
-					using parser_utility::to_raw_error_token;
-					if (tk.code == semicolon)
-					{
-						update_token(begin, end);
-					}
-					else if (is_expr_first(tk.code))
-					{
-						post_err(tk.position, syn_ec::expect_entity_name, to_raw_error_token(tk));
-						parse_expr(begin, end);
-					}
-					else
+					post_err(tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(tk));
+					update_token(begin, end);
+				}
+			}
+			else // list
+			{
+				if (tk.code == right_brackets)
+				{
+					// to ... [ ... ] CURRPOS
+					update_token(begin, end);
+					close_container(begin, end);
+				}
+				else if (tk.code == eof)
+				{
+					post_err(frames.back().open_pos, syn_ec::missing_right_brackets, {});
+					close_container(begin, end);
+				}
+				else if (is_list_element_first(tk.code))
+				{
+					if (!frames.back().with_comma)
 					{
-						post_err(tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(tk));
-						update_token(begin, end);
+						post_err(tk.position, syn_ec::expect_comma, to_raw_error_token(tk));
 					}
+					parse_list_element(begin, end);
+				}
+				else
+				{
+					post_err(tk.position, syn_ec::expect_definition_of_list_element, to_raw_error_token(tk));
+					update_token(begin, end);
 				}
 			}
 		}
 
-		auto parse_decl(auto& begin, auto end) -> entity_type
+		void parse_decl(auto& begin, auto end, type::object<char_t>& o)
 		{
-			// ... iden CURPOS ...
+			// ... CURPOS iden ...
 			// expect : | expr
 
 			using enum pdn_token_code;
+			using err_ms = error_msg_string;
+			using unicode::code_convert;
 			using parser_utility::is_expr_first;
 			using parser_utility::default_entity_value;
 
-			type_code type_c = type_code::unknown;
-			auto type_pos = tk.position;
+			auto target = value_target{ value_use::named };
+			{
+				using string_pr = proxy<type::string<char_t>>;
+				target.name = ::std::move(*::std::get<string_pr>(tk.value));
+				if (o.find(target.name) != o.end())
+				{
+					using raw_err_iden = raw_error_message_type::identifier;
+					post_err(tk.position, syn_ec::entity_redefine, raw_err_iden{ code_convert<err_ms>(target.name) });
+					target.use = value_use::discarded;
+				}
+				else if (declared && frames.empty())
+				{
+					declared->push_back(declaration{ target.name, tk.position });
+				}
+			}
+			if (filter)
+			{
+				target.selected = filter->select_key(current_selection(), target.name);
+				target.skipped = !path_filter<char_t>::is_selected(target.selected);
+			}
+			target.type_pos = tk.position;
 
 			update_token(begin, end);
 			if (tk.code == colon)
 			{
 				update_token(begin, end);
-				type_pos = tk.position;
+				target.type_pos = tk.position;
 
 				if (tk.code == identifier)
 				{
-					type_c = parse_type_spec();
+					target.type_c = parse_type_spec();
 					update_token(begin, end);
 					// ... iden : typename CURPOS(expect expr) ...
 				}
@@ -147,20 +334,11 @@ namespace pdn
 			if (!is_expr_first(tk.code))
 			{
 				post_err(tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(tk));
-				return default_entity_value<char_t>(type_c);
-			}
-
-			auto e = parse_expr(begin, end);
-			// ... iden [colon [typename] ] expr CURPOS ...
-
-			if (type_c != type_code::unknown)
-			{
-				e = entity_cast(::std::move(e), type_c, type_pos);
+				store_value(default_entity_value<char_t>(target.type_c), ::std::move(target));
+				return;
 			}
 
-			// decl end
-
-			return e;
+			parse_expr(begin, end, ::std::move(target));
 		}
 
 		auto parse_type_spec() -> type_code
@@ -184,7 +362,8 @@ namespace pdn
 			return type_c;
 		}
 
-		auto parse_expr(auto& begin, auto end) -> entity_type
+		// parses value of target, list and object are opened and parsed by loop of parse_start
+		void parse_expr(auto& begin, auto end, value_target target)
 		{
 			// expect
 			//     - ...
@@ -199,15 +378,67 @@ namespace pdn
 
 			auto unary_rec = process_unary_operation(begin, end);
 
+			if (target.skipped && parser_utility::is_expr_first(tk.code))
+			{
+				skip_unselected(begin, end);
+				complete_value(begin, end, entity_type{}, ::std::move(target));
+				return;
+			}
+
+			if (tk.code == left_brackets || tk.code == left_curly_brackets)
+			{
+				auto f = frame{};
+				f.container_c = tk.code == left_brackets ? type_code::list : type_code::object;
+				f.open_pos    = tk.position;
+				f.unary_rec   = unary_rec;
+				f.target      = ::std::move(target);
+				if (lazy_base_depth + frames.size() >= max_nesting_depth())
+				{
+					post_err(tk.position, syn_ec::nesting_too_deep, {});
+					skip_container(begin, end);
+					f.container = parser_utility::default_entity_value<char_t>(f.container_c);
+					finish_value(begin, end, ::std::move(f));
+					return;
+				}
+				if (lazy_pending && frames.size() == lazy_depth && is_lazy_target(f))
+				{
+					// body is left for parse_lazy_container, container is recorded when it is stored
+					auto record = lazy_container{ .open_pos = tk.position, .depth = lazy_base_depth + frames.size() };
+					record.close_pos = skip_container_quickly(begin, end);
+					f.container      = parser_utility::default_entity_value<char_t>(f.container_c);
+					record.address   = parser_utility::container_address(f.container);
+					lazy_record      = record;
+					finish_value(begin, end, ::std::move(f));
+					return;
+				}
+				f.container = parser_utility::default_entity_value<char_t>(f.container_c);
+				frames.push_back(::std::move(f));
+				update_token(begin, end);
+				return;
+			}
+
 			if (!parser_utility::is_expr_first(tk.code))
 			{
 				post_err(tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(tk));
-				return type::auto_int{};
+				complete_value(begin, end, type::auto_int{}, ::std::move(target));
+				return;
 			}
 
 			auto result = parse_expr_without_unary(begin, end);
+			apply_unary_operation(result, unary_rec);
+			complete_value(begin, end, ::std::move(result), ::std::move(target));
+		}
+
+		// container which is discarded or replaced by casting is parsed at once for errors, so is its content
+		static bool is_lazy_target(const frame& f) noexcept
+		{
+			return f.target.use != value_use::discarded
+			    && (f.target.type_c == type_code::unknown || f.target.type_c == f.container_c);
+		}
 
-			if (!unary_rec.has_sign) return result;
+		void apply_unary_operation(entity_type& result, const parser_utility::unary_record& unary_rec)
+		{
+			if (!unary_rec.has_sign) return;
 
 			::std::visit([&](auto& arg)
 			{
@@ -257,8 +488,6 @@ namespace pdn
 					         raw_err_unary_op{ err_tkv, operand_type, unary_rec.is_last_sign_negative });
 				}
 			}, result);
-
-			return result;
 		}
 
 		auto parse_expr_without_unary(auto& begin, auto end) -> entity_type
@@ -267,8 +496,7 @@ namespace pdn
 			//     literals
 			//         integer | floating-points | string* | character
 			//     @name
-			//     { ... }
-			//     [ ... ]
+			// { ... } and [ ... ] are opened by caller
 
 			using enum pdn_token_code;
 			switch (tk.code)
@@ -296,18 +524,6 @@ namespace pdn
 				update_token(begin, end);
 				return result;
 			}
-			case left_brackets:
-			{
-				auto left_brackets_pos = tk.position;
-				update_token(begin, end);
-				return parse_list_expr(begin, end, left_brackets_pos);
-			}
-			case left_curly_brackets:
-			{
-				auto left_curly_brackets_pos = tk.position;
-				update_token(begin, end);
-				return parse_object_expr(begin, end, left_curly_brackets_pos);
-			}
 			default:
 				post_err(tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(tk));
 				return type::auto_int{};
@@ -338,138 +554,228 @@ namespace pdn
 			return result;
 		}
 		
-		auto parse_list_expr(auto& begin, auto end, source_position left_brackets_pos) -> entity_type
+		void parse_list_element(auto& begin, auto end)
 		{
-			// ... [ CURRPOS ...
+			// ... [ ... CURPOS iden [colon [typename] ] expr ...
 
-			using parser_utility::is_list_element_first;
-
-			auto result = type::list<char_t>{};
+			auto target = value_target{ value_use::element };
+			target.type_pos = tk.position;
+			if (filter)
+			{
+				auto& f = frames.back();
+				target.selected = filter->select_element(f.target.selected, f.element_count++);
+				target.skipped = !path_filter<char_t>::is_selected(target.selected);
+			}
 
-			for (bool with_comma{ true }; tk.code != pdn_token_code::right_brackets; )
+			if (tk.code == pdn_token_code::identifier)
 			{
-				using parser_utility::to_raw_error_token;
-				if (tk.code == pdn_token_code::eof)
-				{
-					post_err(left_brackets_pos, syn_ec::missing_right_brackets, {});
-					return make_proxy<type::list<char_t>>(::std::move(result));
-				}
-				if (is_list_element_first(tk.code))
+				target.type_c = parse_type_spec();
+				update_token(begin, end);
+				if (tk.code == pdn_token_code::colon)
 				{
-					if (!with_comma)
-					{
-						post_err(tk.position, syn_ec::expect_comma, to_raw_error_token(tk));
-					}
-					result.push_back(parse_list_element(begin, end, with_comma));
+					update_token(begin, end);
 				}
 				else
 				{
-					post_err(tk.position, syn_ec::expect_definition_of_list_element, to_raw_error_token(tk));
-					update_token(begin, end);
+					post_err(tk.position, syn_ec::expect_colon, parser_utility::to_raw_error_token(tk));
 				}
 			}
 
-			// to ... [ ... ] CURRPOS
-			update_token(begin, end);
-
-			return make_proxy<type::list<char_t>>(::std::move(result));
+			parse_expr(begin, end, ::std::move(target));
 		}
 
-		auto parse_list_element(auto& begin, auto end, bool& with_comma) -> entity_type
+		void close_container(auto& begin, auto end)
 		{
-			// ... iden [colon [typename] ] [ ... ] CURPOS ...
+			auto f = ::std::move(frames.back());
+			frames.pop_back();
+			finish_value(begin, end, ::std::move(f));
+		}
 
-			auto type_c = type_code::unknown;
-			auto type_pos = tk.position;
+		// container of closed frame is value of its target
+		void finish_value(auto& begin, auto end, frame f)
+		{
+			apply_unary_operation(f.container, f.unary_rec);
+			complete_value(begin, end, ::std::move(f.container), ::std::move(f.target));
+		}
 
-			if (tk.code == pdn_token_code::identifier)
+		void complete_value(auto& begin, auto end, entity_type e, value_target target)
+		{
+			if (target.use == value_use::element)
 			{
-				type_c = parse_type_spec();
-				update_token(begin, end);
-				if (tk.code == pdn_token_code::colon)
+				// to ... [ (element,)* element CURRPOS ...
+				auto& with_comma = frames.back().with_comma;
+				with_comma = tk.code == pdn_token_code::comma;
+				if (with_comma)
 				{
 					update_token(begin, end);
 				}
-				else
-				{
-					post_err(tk.position, syn_ec::expect_colon, parser_utility::to_raw_error_token(tk));
-				}
 			}
+			if (target.type_c != type_code::unknown && !target.skipped)
+			{
+				e = entity_cast(::std::move(e), target.type_c, target.type_pos);
+			}
+			store_value(::std::move(e), ::std::move(target));
+		}
 
-			entity_type e{ parse_expr(begin, end) };
-			// to ... [ (element,)* element CURRPOS ...
-
-			if (tk.code == pdn_token_code::comma)
+		void store_value(entity_type e, value_target target)
+		{
+			auto lazy = ::std::exchange(lazy_record, ::std::nullopt);
+			if (target.skipped)
 			{
-				update_token(begin, end);
-				with_comma = true;
+				return;
 			}
-			else
+			// unparsed container is recorded only if casting does not replace it
+			if (lazy && (target.use == value_use::named || target.use == value_use::element)
+			         && parser_utility::container_address(e) == lazy->address)
 			{
-				with_comma = false;
+				lazy_pending->push_back(*lazy);
 			}
-
-			if (type_c != type_code::unknown)
+			switch (target.use)
 			{
-				e = entity_cast(::std::move(e), type_c, type_pos);
+			case value_use::named:
+				current_object()[::std::move(target.name)] = ::std::move(e);
+				break;
+			case value_use::element:
+				push_element(::std::move(e));
+				break;
+			case value_use::expanded:
+				*expanded = ::std::move(e);
+				break;
+			default:
+				break;
 			}
-
-			return e;
 		}
 
-		auto parse_object_expr(auto& begin, auto end, source_position left_curly_brackets_pos) -> entity_type
+		// list is packed while its elements are all of one type to be packed (see PDN_Macro_pack_lists),
+		// it is unpacked into entities when element of other type is stored
+		void push_element(entity_type e)
 		{
-			// ... { CURRPOS ...
-
-			using err_ms = error_msg_string;
-			using unicode::code_convert;
-			using parser_utility::is_expr_first;
-
-			auto result = type::object<char_t>{};
-
-			while (tk.code != pdn_token_code::right_curly_brackets)
+			auto& container = frames.back().container;
+			if constexpr (type::config::pack_lists)
 			{
-				using parser_utility::to_raw_error_token;
-				if (tk.code == pdn_token_code::identifier)
+				auto pushed = ::std::visit([&]<typename arg_t>(const arg_t& v)
 				{
-					using string_pr = proxy<type::string<char_t>>;
-					auto iden_p = ::std::get<string_pr>(::std::move(tk.value));
-					if (auto it = result.find(*iden_p); it == result.end())
-					{
-						result[::std::move(*iden_p)] = parse_decl(begin, end);
-					}
-					else
+					if constexpr (type::packed_list::packable<arg_t>)
 					{
-						using raw_err_iden = raw_error_message_type::identifier;
-						post_err(tk.position, syn_ec::entity_redefine, raw_err_iden{ code_convert<err_ms>(*iden_p) });
-						parse_decl(begin, end);
+						auto packed = ::std::get_if<proxy<type::packed_list>>(&container);
+						if (!packed && ::std::as_const(::std::get<proxy<type::list<char_t>>>(container))->empty())
+						{
+							packed = &container.template emplace<proxy<type::packed_list>>();
+						}
+						if (packed && ((*packed)->empty() || (*packed)->template holds<arg_t>()))
+						{
+							(*packed)->push_back(v);
+							return true;
+						}
 					}
+					return false;
+				}, e);
+				if (pushed)
+				{
+					return;
 				}
-				else if (tk.code == pdn_token_code::semicolon)
+				unpack(container);
+			}
+			::std::get<proxy<type::list<char_t>>>(container)->push_back(::std::move(e));
+		}
+
+		auto current_object() -> type::object<char_t>&
+		{
+			return frames.empty() ? *root_object : *::std::get<proxy<type::object<char_t>>>(frames.back().container);
+		}
+
+		auto current_selection() const -> const selection&
+		{
+			return frames.empty() ? root_selection : frames.back().target.selected;
+		}
+
+		// skips list or object, only brackets are processed.
+		// right bracket of the other kind does not close it, as it is ignored in parse_start.
+		// returns position of its right bracket, nullopt if eof is reached before it.
+		auto skip_container(auto& begin, auto end) -> ::std::optional<source_position>
+		{
+			// CURPOS [ ... ] or CURPOS { ... }
+
+			using enum pdn_token_code;
+			auto& opened = skipped_objects;
+			opened.clear();
+			for (; tk.code != eof; update_token(begin, end))
+			{
+				if (tk.code == left_brackets || tk.code == left_curly_brackets)
 				{
-					update_token(begin, end);
+					opened.push_back(tk.code == left_curly_brackets);
 				}
-				else if (is_expr_first(tk.code))
+				else if ((tk.code == right_brackets || tk.code == right_curly_brackets)
+				      && opened.back() == (tk.code == right_curly_brackets))
 				{
-					post_err(tk.position, syn_ec::expect_entity_name, to_raw_error_token(tk));
-					parse_expr(begin, end);
+					opened.pop_back();
+					if (opened.empty())
+					{
+						auto close_pos = tk.position;
+						update_token(begin, end);
+						return close_pos;
+					}
 				}
-				else if (tk.code == pdn_token_code::eof)
+			}
+			return ::std::nullopt;
+		}
+
+		// skip_container by skipping mode of lexer if token iterator supports it
+		auto skip_container_quickly(auto& begin, auto end) -> ::std::optional<source_position>
+		{
+			// CURPOS [ ... ] or CURPOS { ... }
+
+			if constexpr (concepts::container_skipping_token_iterator<::std::remove_cvref_t<decltype(begin)>>)
+			{
+				if (begin != end)
 				{
-					post_err(left_curly_brackets_pos, syn_ec::missing_right_curly_brackets, {});
-					return make_proxy<type::object<char_t>>(::std::move(result));
+					begin.skip_container(tk.code);
 				}
-				else
+				update_token(begin, end); // to ... [ ... CURPOS ]
+				auto close_pos = tk.code == pdn_token_code::eof ? ::std::nullopt : ::std::optional{ tk.position };
+				update_token(begin, end); // to ... [ ... ] CURPOS
+				return close_pos;
+			}
+			else
+			{
+				return skip_container(begin, end);
+			}
+		}
+
+		// skips value not selected by path_filter, nothing is made of it.
+		void skip_unselected(auto& begin, auto end)
+		{
+			// CURPOS value
+
+			using enum pdn_token_code;
+			switch (tk.code)
+			{
+			case left_brackets:
+			case left_curly_brackets:
+				skip_container_quickly(begin, end);
+				break;
+			case literal_string:
+				while (tk.code == literal_string) // concatenation
 				{
-					post_err(tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(tk));
 					update_token(begin, end);
 				}
+				break;
+			default:
+				update_token(begin, end);
+				break;
 			}
+		}
 
-			// to ... { ... } CURRPOS
-			update_token(begin, end);
-
-			return make_proxy<type::object<char_t>>(::std::move(result));
+		auto max_nesting_depth() const -> ::std::size_t
+		{
+			if constexpr (concepts::nesting_depth_limiter<function_package>)
+			{
+				return func_pkg->max_nesting_depth();
+			}
+			else
+			{
+				return parser_utility::default_max_nesting_depth;
+			}
 		}
 
 		auto entity_cast(entity_type src, type_code target_type_c, source_position type_pos) -> entity_type
@@ -523,6 +829,10 @@ namespace pdn
 				{
 					return entity_type{ ::std::move(arg) };
 				}
+				else if constexpr (::std::same_as<src_t, type::packed_list> && tar_c == type_code::list)
+				{
+					return entity_type{ ::std::move(arg) }; // packed list is list
+				}
 				else if constexpr (pdn_sint<src_t>)
 				{
 					if constexpr (pdn_sint<tar_t>)
@@ -696,8 +1006,20 @@ namespace pdn
 			func_pkg->handle_error(error_message{ err_c, pos, err_msg_gen(pos, err_c, ::std::move(raw_msg)) });
 		}
 	private:
-		function_package* func_pkg{};
-		token<char_t>     tk{};
+		function_package*           func_pkg{};
+		token<char_t>               tk{};
+		::std::vector<frame>        frames{};         // opened lists and objects, innermost is back
+		type::object<char_t>*       root_object{};    // object of document being parsed
+		const path_filter<char_t>*  filter{};         // null if all entities are made
+		selection                   root_selection{}; // selection of root_object
+		::std::vector<declaration>* declared{};       // names declared in root_object, null if they are not recorded
+		::std::vector<bool>         skipped_objects{}; // opened brackets in skip_container, true for object
+		// lazy parsing, see parse_lazy
+		::std::vector<lazy_container>*  lazy_pending{};    // null if lists and objects are parsed at once
+		::std::size_t                   lazy_depth{};      // lists and objects opened at this depth are left unparsed
+		::std::size_t                   lazy_base_depth{}; // nesting depth of container parsed by parse_lazy_container
+		::std::optional<lazy_container> lazy_record{};     // unparsed container being stored
+		entity_type*                    expanded{};        // target of parse_lazy_container
 	};
 }
 
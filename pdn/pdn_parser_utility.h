@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <concepts>
 #include <cstddef>
+#include <optional>
 
 #include "pdn_entity.h"
 #include "pdn_type.h"
@@ -31,6 +32,13 @@ namespace pdn::concepts
 		++it;
 	};
 
+	// token iterator skips rest of list or object without making tokens, see token_iterator_from_lexer::skip_container
+	template <typename type>
+	concept container_skipping_token_iterator = requires (type it, pdn_token_code opening)
+	{
+		it.skip_container(opening);
+	};
+
 	template <typename type>
 	concept utf8_code_unit_iterator = requires (type it)
 	{
@@ -54,6 +62,13 @@ namespace pdn::concepts
 		 = utf8_code_unit_iterator<type>
 		|| utf16_code_unit_iterator<type>
 		|| utf32_code_unit_iterator<type>;
+	// function package limits nesting of list and object, parser uses default_max_nesting_depth without it
+	template <typename type>
+	concept nesting_depth_limiter = requires (const type& limiter)
+	{
+		{ limiter.max_nesting_depth() } -> ::std::convertible_to<::std::size_t>;
+	};
+
 	template <typename type>
 	concept utf_code_unit_string_view
 		 = requires(type sv) { sv.cbegin(); sv.cend(); }
@@ -62,6 +77,8 @@ namespace pdn::concepts
 
 namespace pdn::parser_utility
 {
+	inline constexpr ::std::size_t default_max_nesting_depth = 1024;
+
 	constexpr bool is_unary_operator(pdn_token_code code) noexcept
 	{
 		return code == pdn_token_code::minus || code == pdn_token_code::plus;
@@ -149,6 +166,38 @@ namespace pdn::parser_utility
 		bool            has_sign{};               // true => this object is valid
 		explicit unary_record(bool v) : has_sign{ v } {}
 	};
+
+	// list or object whose body is left unparsed by lazy parsing
+	struct lazy_container
+	{
+		const void*                      address{};   // address of list or object held by proxy, it is kept when proxy moves
+		source_position                  open_pos{};  // position of left bracket
+		::std::size_t                    depth{};     // nesting depth, count of lists and objects enclosing it
+		::std::optional<source_position> close_pos{}; // position of right bracket, nullopt if eof is reached before it
+	};
+
+	// address of list or object held by entity, nullptr for other types
+	template <typename char_t>
+	auto container_address(const entity<char_t>& e) noexcept -> const void*
+	{
+		if (auto p = ::std::get_if<proxy<type::list<char_t>>>(&e))
+		{
+			return p->get();
+		}
+		if (auto p = ::std::get_if<proxy<type::object<char_t>>>(&e))
+		{
+			return p->get();
+		}
+		return nullptr;
+	}
+
+	// named entity declared in root object of document, for merging objects parsed from parts of document
+	template <typename char_t>
+	struct declaration
+	{
+		type::string<char_t> name{};
+		source_position      position{}; // position of name
+	};
 }
 
 #endif
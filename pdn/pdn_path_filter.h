@@ -0,0 +1,240 @@
+#ifndef PDN_Header_pdn_path_filter
+#define PDN_Header_pdn_path_filter
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+#include <limits>
+#include <functional>
+
+#include "pdn_unicode_base.h"
+#include "pdn_utf_code_convert.h"
+#include "pdn_type.h"
+
+namespace pdn
+{
+	// key paths selecting parts of document for parse, such as
+	//     u8"server.listen"   entity listen in object server
+	//     u8"limits[*].rate"  entity rate in each element of list limits
+	//     u8"matrix[0][1]"    second element of first element of list matrix
+	// selected entity is made with all its content, its parents are made with selected content only,
+	// selected elements of list keep their order but not their indexes (unselected elements are omitted).
+	// value on the way of a path which is neither list nor object is made as it is.
+	template <unicode::concepts::code_unit char_t>
+	class path_filter
+	{
+	private:
+		static constexpr ::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+		struct node
+		{
+			::std::unordered_map<type::string<char_t>, ::std::size_t, type::config::key_hasher, ::std::equal_to<>> keys{};
+			::std::unordered_map<::std::size_t, ::std::size_t> indexes{};
+			::std::size_t                                      any_index{ npos };
+			bool                                               terminal{}; // end of path
+		};
+	public:
+		using char_type = char_t;
+		// state of entity in document
+		//     whole: entity is selected, all its content is selected
+		//     nodes: paths which go through entity, its content is selected by them
+		// entity is not selected if both are empty
+		struct selection
+		{
+			bool                         whole{};
+			::std::vector<::std::size_t> nodes{};
+		};
+	public:
+		// returns false and adds nothing if path is malformed
+		template <unicode::concepts::code_unit path_char_t>
+		bool add(::std::basic_string_view<path_char_t> path)
+		{
+			if constexpr (::std::same_as<path_char_t, char_t>)
+			{
+				return add_path(path);
+			}
+			else
+			{
+				const auto converted = unicode::code_convert<type::string<char_t>>(path);
+				return add_path(converted);
+			}
+		}
+		template <unicode::concepts::code_unit path_char_t>
+		bool add(const path_char_t* path)
+		{
+			return add(::std::basic_string_view<path_char_t>{ path });
+		}
+		auto root() const -> selection
+		{
+			return selection{ .whole = false, .nodes = { 0 } };
+		}
+		auto select_key(const selection& parent, ::std::basic_string_view<char_t> key) const -> selection
+		{
+			auto result = selection{ .whole = parent.whole, .nodes = {} };
+			if (result.whole)
+			{
+				return result;
+			}
+			for (auto n : parent.nodes)
+			{
+				const auto& keys = nodes[n].keys;
+				if (auto it = keys.find(key); it != keys.end() && select_node(it->second, result))
+				{
+					break;
+				}
+			}
+			return result;
+		}
+		auto select_element(const selection& parent, ::std::size_t index) const -> selection
+		{
+			auto result = selection{ .whole = parent.whole, .nodes = {} };
+			if (result.whole)
+			{
+				return result;
+			}
+			for (auto n : parent.nodes)
+			{
+				const auto& indexes = nodes[n].indexes;
+				if (auto it = indexes.find(index); it != indexes.end() && select_node(it->second, result))
+				{
+					break;
+				}
+				if (nodes[n].any_index != npos && select_node(nodes[n].any_index, result))
+				{
+					break;
+				}
+			}
+			return result;
+		}
+		static bool is_selected(const selection& s) noexcept
+		{
+			return s.whole || !s.nodes.empty();
+		}
+
+		path_filter() = default;
+		// malformed paths are ignored
+		path_filter(::std::initializer_list<::std::basic_string_view<char_t>> paths)
+		{
+			for (auto path : paths)
+			{
+				add(path);
+			}
+		}
+	private:
+		// returns true if entity is selected whole
+		bool select_node(::std::size_t n, selection& result) const
+		{
+			if (nodes[n].terminal)
+			{
+				result.whole = true;
+				result.nodes.clear();
+				return true;
+			}
+			result.nodes.push_back(n);
+			return false;
+		}
+
+		// path := name ( '.' name | '[' index ']' | '[' '*' ']' )*
+		// name is non-empty sequence of code units except '.', '[' and ']'
+		bool add_path(::std::basic_string_view<char_t> path)
+		{
+			struct step
+			{
+				::std::basic_string_view<char_t> key{};
+				::std::size_t                    index{ npos }; // npos with empty key is [*]
+			};
+			::std::vector<step> steps{};
+
+			auto is_delimiter = [](char_t c) { return c == char_t('.') || c == char_t('[') || c == char_t(']'); };
+			auto read_name = [&](::std::size_t& pos) -> bool
+			{
+				auto first = pos;
+				while (pos < path.size() && !is_delimiter(path[pos])) ++pos;
+				steps.push_back(step{ .key = path.substr(first, pos - first) });
+				return pos != first;
+			};
+			auto read_index = [&](::std::size_t& pos) -> bool
+			{
+				// CURPOS [ ... ]
+				++pos;
+				if (pos < path.size() && path[pos] == char_t('*'))
+				{
+					++pos;
+					steps.push_back(step{});
+				}
+				else
+				{
+					auto first = pos;
+					auto index = ::std::size_t{};
+					for (; pos < path.size() && path[pos] >= char_t('0') && path[pos] <= char_t('9'); ++pos)
+					{
+						auto digit = static_cast<::std::size_t>(path[pos] - char_t('0'));
+						if (index > (npos - 1 - digit) / 10) return false;
+						index = index * 10 + digit;
+					}
+					if (pos == first) return false;
+					steps.push_back(step{ .index = index });
+				}
+				return pos < path.size() && path[pos++] == char_t(']');
+			};
+
+			::std::size_t pos{};
+			if (!read_name(pos))
+			{
+				return false;
+			}
+			while (pos < path.size())
+			{
+				auto c = path[pos];
+				if (c == char_t('.'))
+				{
+					++pos;
+					if (!read_name(pos)) return false;
+				}
+				else if (c == char_t('['))
+				{
+					if (!read_index(pos)) return false;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			::std::size_t n{};
+			for (const auto& s : steps)
+			{
+				n = child(n, s.key, s.index);
+			}
+			nodes[n].terminal = true;
+			return true;
+		}
+
+		auto child(::std::size_t n, ::std::basic_string_view<char_t> key, ::std::size_t index) -> ::std::size_t
+		{
+			auto next = nodes.size();
+			if (!key.empty())
+			{
+				auto [it, inserted] = nodes[n].keys.try_emplace(type::string<char_t>{ key }, next);
+				if (!inserted) return it->second;
+			}
+			else if (index != npos)
+			{
+				auto [it, inserted] = nodes[n].indexes.try_emplace(index, next);
+				if (!inserted) return it->second;
+			}
+			else
+			{
+				if (nodes[n].any_index != npos) return nodes[n].any_index;
+				nodes[n].any_index = next;
+			}
+			nodes.emplace_back();
+			return next;
+		}
+	private:
+		::std::vector<node> nodes = ::std::vector<node>(1); // nodes[0] is root object of document
+	};
+}
+
+#endif
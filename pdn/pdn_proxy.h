@@ -5,39 +5,75 @@
 #include <utility>
 #include <memory>
 
+#include "pdn_memory_resource.h"
+
 namespace pdn
 {
+	// proxy made by default or moved from holds nothing, so making and moving it allocate nothing.
+	// non-const access makes t by default at first, so proxy is never null when it is observed;
+	// const access never makes t, proxy holding nothing is read as one shared empty t, so const access is thread safe.
 	template <typename t>
 	class proxy
 	{
 	private:
+#if defined(PDN_Macro_entity_memory_resource)
+		using handle_type = ::std::unique_ptr<t, detail::resource_deleter<t>>;
+#else
 		using handle_type = ::std::unique_ptr<t>;
+#endif
+		template <typename... args_t>
+		static auto make_handle(args_t&&... args) -> handle_type
+		{
+#if defined(PDN_Macro_entity_memory_resource)
+			return detail::allocate_in_resource<t>(::std::forward<args_t>(args)...);
+#else
+			return ::std::make_unique<t>(::std::forward<args_t>(args)...);
+#endif
+		}
+		static auto empty_value() -> const t&
+		{
+			static const t empty{};
+			return empty;
+		}
 	public:
 		using element_type = typename handle_type::element_type;
 		using pointer      = typename handle_type::pointer;
 		using deleter_type = typename handle_type::deleter_type;
 		explicit operator bool() const noexcept
 		{
-			return static_cast<bool>(handle);
+			return true; // get() is never null
 		}
-		auto get() const noexcept -> pointer
+		auto get() -> pointer
 		{
+			if (!handle) [[unlikely]]
+			{
+				handle = make_handle();
+			}
 			return handle.get();
 		}
-		auto operator*() const noexcept -> ::std::add_lvalue_reference_t<t>
+		auto get() const -> const t*
 		{
-			return *handle;
+			return handle ? handle.get() : &empty_value();
 		}
-		auto operator->() const noexcept -> pointer
+		auto operator*() -> ::std::add_lvalue_reference_t<t>
 		{
-			return handle.get();
+			return *get();
+		}
+		auto operator*() const -> const t&
+		{
+			return *get();
+		}
+		auto operator->() -> pointer
+		{
+			return get();
 		}
-		proxy() : proxy(::std::make_unique<t>()) {}
-		proxy(const proxy& o) : proxy(::std::make_unique<t>(*o)) {}
-		proxy(proxy&& o) noexcept : proxy()
+		auto operator->() const -> const t*
 		{
-			*this = ::std::move(o);
+			return get();
 		}
+		proxy() noexcept = default;
+		proxy(const proxy& o) : handle{ o.handle ? make_handle(*o.handle) : handle_type{} } {}
+		proxy(proxy&& o) noexcept : handle{ ::std::move(o.handle) } {}
 		proxy& operator=(const proxy& o)
 		{
 			*this = proxy{ o };
@@ -51,7 +87,7 @@ namespace pdn
 		template <typename type, typename... args_t>
 		friend auto make_proxy(args_t&&... args) -> proxy<type>;
 	private:
-		handle_type handle{};
+		handle_type handle{}; // made by non-const get() if it is null
 		explicit proxy(handle_type h) : handle{ ::std::move(h) } {}
 	};
 
@@ -64,7 +100,7 @@ namespace pdn
 	template <typename type, typename... args_t>
 	auto make_proxy(args_t&&... args) -> proxy<type>
 	{
-		return proxy<type>{ ::std::make_unique<type>(::std::forward<args_t>(args)...) };
+		return proxy<type>{ proxy<type>::make_handle(::std::forward<args_t>(args)...) };
 	}
 
 	template <typename t>
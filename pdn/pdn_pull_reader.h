@@ -0,0 +1,520 @@
+#ifndef PDN_Header_pdn_pull_reader
+#define PDN_Header_pdn_pull_reader
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <deque>
+#include <string_view>
+
+#include "pdn_unicode_base.h"
+#include "pdn_type.h"
+#include "pdn_entity.h"
+#include "pdn_token_code.h"
+#include "pdn_token.h"
+#include "pdn_type_code.h"
+#include "pdn_syntax_error_code.h"
+#include "pdn_source_position.h"
+
+#include "pdn_code_point_iterator.h"
+#include "pdn_lexer.h"
+#include "pdn_parser.h"
+#include "pdn_parser_utility.h"
+
+namespace pdn
+{
+	enum class pull_event : unsigned char
+	{
+		none,            // next() is not called
+		key,             // name of entity, followed by event(s) of its value
+		begin_object,
+		begin_list,
+		end,             // end of object or list
+		value,           // value of basic type, character or string
+		end_of_document,
+	};
+
+	// reader walks document by next() instead of building entity,
+	// uninteresting value can be skipped by skip() without keeping it.
+	// memory used is O(depth of document) except current event.
+	// document is the implicit root object, its definitions are read as keys without begin_object and end.
+	// grammar, casting and errors are same as parser, except that redefinition of entity is not detected,
+	// every definition is read in order of source. nesting is limited by max nesting depth as parser.
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::function_package_for_parser<char_t> function_package,
+	          typename                                      token_it_t,
+	          typename                                      token_end_t>
+	class pull_reader
+	{
+	public:
+		using char_type   = char_t;
+		using entity_type = entity<char_type>;
+		using key_type    = ::std::basic_string_view<char_type>;
+		using size_type   = ::std::size_t;
+	private:
+		using syn_ec    = syntax_error_code;
+		using core_type = parser<char_type, function_package>;
+		struct event_record
+		{
+			pull_event             kind{ pull_event::none };
+			source_position        position{};
+			type::string<char_t>   name{};    // for key
+			entity_type            value{};   // for value
+		};
+		enum class frame_use : unsigned char
+		{
+			reported, // container is read by events
+			dropped,  // container is casted to other type, default value of that type is read after it
+			discarded // container is not a value of entity, it is parsed for errors only
+		};
+		struct frame
+		{
+			type_code                    container_c{};
+			frame_use                    use{};
+			source_position              open_pos{};
+			source_position              value_pos{};
+			source_position              type_pos{};
+			type_code                    type_c{};
+			parser_utility::unary_record unary_rec{ false };
+			bool                         with_comma{ true };
+		};
+	public:
+		// moves to next event, returns false at end of document
+		bool next()
+		{
+			if (current.kind == pull_event::end_of_document)
+			{
+				return false;
+			}
+			while (pending.empty())
+			{
+				advance();
+			}
+			current = ::std::move(pending.front());
+			pending.pop_front();
+			return current.kind != pull_event::end_of_document;
+		}
+		// skips value of current key or rest of current object or list,
+		// current event is the last skipped one (end of skipped container).
+		void skip()
+		{
+			if (current.kind == pull_event::key)
+			{
+				next();
+			}
+			if (current.kind != pull_event::begin_object && current.kind != pull_event::begin_list)
+			{
+				return;
+			}
+			for (size_type level{ 1 }; level != 0 && next(); )
+			{
+				if (current.kind == pull_event::begin_object || current.kind == pull_event::begin_list)
+				{
+					++level;
+				}
+				else if (current.kind == pull_event::end)
+				{
+					--level;
+				}
+			}
+		}
+		pull_event kind() const noexcept
+		{
+			return current.kind;
+		}
+		source_position position() const noexcept
+		{
+			return current.position;
+		}
+		// name of entity, valid when kind() is key
+		key_type key() const noexcept
+		{
+			return current.name;
+		}
+		// valid when kind() is value
+		const entity_type& value() const noexcept
+		{
+			return current.value;
+		}
+		template <typename target_t>
+		auto value() const -> const target_t&
+		{
+			return current.value.template get<target_t>();
+		}
+		pull_reader(token_it_t begin, token_end_t end, function_package& function_pkg) :
+			core{ function_pkg },
+			token_begin{ ::std::move(begin) },
+			token_end{ ::std::move(end) }
+		{
+			core.update_token(token_begin, token_end);
+		}
+	private:
+		// reads tokens until at least one event is pending
+		void advance()
+		{
+			using enum pdn_token_code;
+			using parser_utility::is_expr_first;
+			using parser_utility::is_list_element_first;
+			using parser_utility::to_raw_error_token;
+
+			auto& tk = core.tk;
+			if (frames.empty()) // root object
+			{
+				if (tk.code == identifier)
+				{
+					read_decl();
+				}
+				else if (tk.code == semicolon)
+				{
+					update_token();
+				}
+				else if (is_expr_first(tk.code))
+				{
+					core.post_err(tk.position, syn_ec::expect_entity_name, to_raw_error_token(tk));
+					read_value(type_code::unknown, tk.position, false, true);
+				}
+				else if (tk.code == eof)
+				{
+					pending.push_back(event_record{ pull_event::end_of_document, tk.position });
+				}
+				else
+				{
+					core.post_err(tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(tk));
+					update_token();
+				}
+			}
+			else if (frames.back().container_c == type_code::list)
+			{
+				if (tk.code == right_brackets)
+				{
+					close_container(true);
+				}
+				else if (tk.code == eof)
+				{
+					core.post_err(frames.back().open_pos, syn_ec::missing_right_brackets, {});
+					close_container(false);
+				}
+				else if (is_list_element_first(tk.code))
+				{
+					if (!frames.back().with_comma)
+					{
+						core.post_err(tk.position, syn_ec::expect_comma, to_raw_error_token(tk));
+					}
+					read_list_element();
+				}
+				else
+				{
+					core.post_err(tk.position, syn_ec::expect_definition_of_list_element, to_raw_error_token(tk));
+					update_token();
+				}
+			}
+			else // object
+			{
+				if (tk.code == right_curly_brackets)
+				{
+					close_container(true);
+				}
+				else if (tk.code == identifier)
+				{
+					read_decl();
+				}
+				else if (tk.code == semicolon)
+				{
+					update_token();
+				}
+				else if (is_expr_first(tk.code))
+				{
+					core.post_err(tk.position, syn_ec::expect_entity_name, to_raw_error_token(tk));
+					read_value(type_code::unknown, tk.position, false, true);
+				}
+				else if (tk.code == eof)
+				{
+					core.post_err(frames.back().open_pos, syn_ec::missing_right_curly_brackets, {});
+					close_container(false);
+				}
+				else
+				{
+					core.post_err(tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(tk));
+					update_token();
+				}
+			}
+		}
+
+		void read_decl()
+		{
+			// ... CURPOS iden ...
+
+			using enum pdn_token_code;
+			using parser_utility::is_expr_first;
+			using parser_utility::default_entity_value;
+
+			auto& tk = core.tk;
+			{
+				using string_pr = proxy<type::string<char_t>>;
+				push(event_record{ pull_event::key, tk.position, ::std::move(*::std::get<string_pr>(tk.value)) });
+			}
+
+			type_code type_c = type_code::unknown;
+			auto type_pos = tk.position;
+
+			update_token();
+			if (tk.code == colon)
+			{
+				update_token();
+				type_pos = tk.position;
+
+				if (tk.code == identifier)
+				{
+					type_c = core.parse_type_spec();
+					update_token();
+				}
+			}
+
+			if (!is_expr_first(tk.code))
+			{
+				core.post_err(tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(tk));
+				push_entity(default_entity_value<char_t>(type_c), tk.position);
+				return;
+			}
+
+			read_value(type_c, type_pos, false, false);
+		}
+
+		void read_list_element()
+		{
+			// ... [ ... CURPOS iden [colon [typename] ] [ ... ] ...
+
+			auto& tk = core.tk;
+			auto type_c = type_code::unknown;
+			auto type_pos = tk.position;
+
+			if (tk.code == pdn_token_code::identifier)
+			{
+				type_c = core.parse_type_spec();
+				update_token();
+				if (tk.code == pdn_token_code::colon)
+				{
+					update_token();
+				}
+				else
+				{
+					core.post_err(tk.position, syn_ec::expect_colon, parser_utility::to_raw_error_token(tk));
+				}
+			}
+
+			read_value(type_c, type_pos, true, false);
+		}
+
+		// reads expression, container is opened and read by following events
+		void read_value(type_code type_c, source_position type_pos, bool list_element, bool discarded)
+		{
+			using enum pdn_token_code;
+			using parser_utility::default_entity_value;
+
+			auto& tk = core.tk;
+			auto value_pos = tk.position;
+			auto unary_rec = core.process_unary_operation(token_begin, token_end);
+			auto result = entity_type{ type::auto_int{} };
+
+			if ((tk.code == left_brackets || tk.code == left_curly_brackets) && frames.size() >= core.max_nesting_depth())
+			{
+				// empty container stands for the one nested too deep
+				const auto container_c = tk.code == left_brackets ? type_code::list : type_code::object;
+				core.post_err(tk.position, syn_ec::nesting_too_deep, {});
+				core.skip_container(token_begin, token_end);
+				result = default_entity_value<char_t>(container_c);
+				core.apply_unary_operation(result, unary_rec);
+			}
+			else if (tk.code == left_brackets || tk.code == left_curly_brackets)
+			{
+				auto f = frame{};
+				f.container_c = tk.code == left_brackets ? type_code::list : type_code::object;
+				f.use         = discarded ? frame_use::discarded
+				              : type_c != type_code::unknown && type_c != f.container_c ? frame_use::dropped
+				              : frame_use::reported;
+				f.open_pos    = tk.position;
+				f.value_pos   = value_pos;
+				f.type_pos    = type_pos;
+				f.type_c      = type_c;
+				f.unary_rec   = unary_rec;
+				if (f.use != frame_use::reported)
+				{
+					++muted_depth;
+				}
+				push(event_record{ f.container_c == type_code::list ? pull_event::begin_list : pull_event::begin_object, tk.position });
+				frames.push_back(f);
+				update_token();
+				return;
+			}
+			else if (!parser_utility::is_expr_first(tk.code))
+			{
+				core.post_err(tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(tk));
+			}
+			else
+			{
+				result = core.parse_expr_without_unary(token_begin, token_end);
+				core.apply_unary_operation(result, unary_rec);
+			}
+			if (list_element)
+			{
+				read_comma();
+			}
+			if (discarded)
+			{
+				return;
+			}
+			if (type_c != type_code::unknown)
+			{
+				result = core.entity_cast(::std::move(result), type_c, type_pos);
+			}
+			push_entity(::std::move(result), value_pos);
+		}
+
+		void close_container(bool has_closing_token)
+		{
+			using parser_utility::default_entity_value;
+
+			auto f = frames.back();
+			frames.pop_back();
+			push(event_record{ pull_event::end, core.tk.position });
+			if (f.use != frame_use::reported)
+			{
+				--muted_depth;
+			}
+			if (has_closing_token)
+			{
+				update_token();
+			}
+			// empty container stands for the closed one, errors of unary operation and casting do not use its content
+			auto stand_in = entity_type{};
+			if (f.unary_rec.has_sign || f.use == frame_use::dropped)
+			{
+				stand_in = default_entity_value<char_t>(f.container_c);
+				core.apply_unary_operation(stand_in, f.unary_rec);
+			}
+			if (!frames.empty() && frames.back().container_c == type_code::list)
+			{
+				read_comma();
+			}
+			if (f.use == frame_use::dropped)
+			{
+				push_entity(core.entity_cast(::std::move(stand_in), f.type_c, f.type_pos), f.value_pos);
+			}
+		}
+
+		void read_comma()
+		{
+			// ... [ (element,)* element CURRPOS ...
+			if (core.tk.code == pdn_token_code::comma)
+			{
+				update_token();
+				frames.back().with_comma = true;
+			}
+			else
+			{
+				frames.back().with_comma = false;
+			}
+		}
+
+		void push(event_record&& event)
+		{
+			if (muted_depth == 0)
+			{
+				pending.push_back(::std::move(event));
+			}
+		}
+
+		// value of entity, containers (such as constants or default values) are read by events of their content
+		void push_entity(entity_type e, source_position pos)
+		{
+			if (muted_depth != 0)
+			{
+				return;
+			}
+			unpack(e); // packed list is read by events of its elements
+			if (auto list_p = ::std::get_if<proxy<type::list<char_t>>>(&e))
+			{
+				pending.push_back(event_record{ pull_event::begin_list, pos });
+				for (auto& element : **list_p)
+				{
+					push_entity(::std::move(element), pos);
+				}
+				pending.push_back(event_record{ pull_event::end, pos });
+			}
+			else if (auto object_p = ::std::get_if<proxy<type::object<char_t>>>(&e))
+			{
+				pending.push_back(event_record{ pull_event::begin_object, pos });
+				for (auto& [name, member] : **object_p)
+				{
+					pending.push_back(event_record{ pull_event::key, pos, name });
+					push_entity(::std::move(member), pos);
+				}
+				pending.push_back(event_record{ pull_event::end, pos });
+			}
+			else
+			{
+				pending.push_back(event_record{ pull_event::value, pos, {}, ::std::move(e) });
+			}
+		}
+
+		void update_token()
+		{
+			core.update_token(token_begin, token_end);
+		}
+	private:
+		core_type                   core;          // grammar of values, current token and function package
+		token_it_t                  token_begin;
+		token_end_t                 token_end;
+		::std::vector<frame>        frames;        // opened containers
+		::std::deque<event_record>  pending;       // events read but not reached by next()
+		event_record                current{};
+		size_type                   muted_depth{}; // events are dropped while it is not 0
+	};
+
+	// for token iterator
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::token_iterator<char_t>              it_t,
+	          typename                                      end_t,
+	          concepts::function_package_for_parser<char_t> fn_pkg>
+	inline auto make_pull_reader(it_t begin, end_t end, fn_pkg& fp, char_t = {})
+	{
+		return pull_reader<char_t, fn_pkg, it_t, end_t>{ ::std::move(begin), ::std::move(end), fp };
+	}
+	// for code_unit iterator, function packages must outlive reader
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_iterator                   it_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	inline auto make_pull_reader(it_t               begin,
+	                             auto               end,
+	                             fn_pkg_for_cp_it&  cp_it_fp,
+	                             fn_pkg_for_lexer&  lex_fp,
+	                             fn_pkg_for_parser& par_fp,
+	                             char_t             char_tag = {})
+	{
+		lexer<char_t, fn_pkg_for_lexer> lex{ lex_fp };
+		auto cp_it     = make_code_point_iterator(begin, end, cp_it_fp);
+		auto token_it  = make_token_iterator(lex, cp_it, end);
+		auto token_end = make_end_token_iterator(token_it);
+		return make_pull_reader(::std::move(token_it), ::std::move(token_end), par_fp, char_tag);
+	}
+	// for utf_code_unit_string_view, function packages and viewed string must outlive reader
+	template <unicode::concepts::code_unit                       char_t,
+	          concepts::utf_code_unit_string_view                str_view_t,
+	          concepts::function_package_for_code_point_iterator fn_pkg_for_cp_it,
+	          concepts::function_package_for_lexer               fn_pkg_for_lexer,
+	          concepts::function_package_for_parser<char_t>      fn_pkg_for_parser>
+	inline auto make_pull_reader(str_view_t         sv,
+	                             fn_pkg_for_cp_it&  cp_it_fp,
+	                             fn_pkg_for_lexer&  lex_fp,
+	                             fn_pkg_for_parser& par_fp,
+	                             char_t             char_tag = {})
+	{
+		return make_pull_reader(::std::cbegin(sv), ::std::cend(sv), cp_it_fp, lex_fp, par_fp, char_tag);
+	}
+}
+
+#endif
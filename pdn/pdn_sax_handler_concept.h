@@ -0,0 +1,44 @@
+#ifndef PDN_Header_pdn_sax_handler_concept
+#define PDN_Header_pdn_sax_handler_concept
+
+#include <string_view>
+
+#include "pdn_type.h"
+#include "pdn_source_position.h"
+#include "pdn_error_message.h"
+
+namespace pdn::concepts
+{
+	// receiver of events of sax_parser
+	// on_key(name, pos) is followed by events of its value,
+	// on_begin_object(pos) and on_begin_list(pos) are closed by on_end(pos),
+	// string and key are views into buffer of parser, they are valid during the call only.
+	template <typename handler_t, typename char_t>
+	concept sax_handler = requires (handler_t                          handler,
+	                                source_position                    pos,
+	                                ::std::basic_string_view<char_t>   sv,
+	                                const type::character<char_t>&     c,
+	                                const error_message&               err_msg)
+	{
+		handler.on_key(sv, pos);
+		handler.on_begin_object(pos);
+		handler.on_begin_list(pos);
+		handler.on_end(pos);
+		handler.on_value(type::i8{}, pos);
+		handler.on_value(type::i16{}, pos);
+		handler.on_value(type::i32{}, pos);
+		handler.on_value(type::i64{}, pos);
+		handler.on_value(type::u8{}, pos);
+		handler.on_value(type::u16{}, pos);
+		handler.on_value(type::u32{}, pos);
+		handler.on_value(type::u64{}, pos);
+		handler.on_value(type::f32{}, pos);
+		handler.on_value(type::f64{}, pos);
+		handler.on_value(type::boolean{}, pos);
+		handler.on_value(c, pos);
+		handler.on_value(sv, pos);
+		handler.on_error(err_msg);
+	};
+}
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef PDN_Header_pdn_sax_parser
+#define PDN_Header_pdn_sax_parser
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <variant>
+#include <concepts>
+#include <type_traits>
+#include <string_view>
+
+#include "pdn_unicode_base.h"
+#include "pdn_type.h"
+#include "pdn_entity.h"
+#include "pdn_token_code.h"
+#include "pdn_token.h"
+#include "pdn_type_code.h"
+#include "pdn_error_string.h"
+#include "pdn_error_message.h"
+#include "pdn_syntax_error_code.h"
+#include "pdn_raw_error_message_variant.h"
+#include "pdn_source_position.h"
+
+#include "pdn_sax_handler_concept.h"
+#include "pdn_function_package.h"
+#include "pdn_parser.h"
+#include "pdn_parser_utility.h"
+
+namespace pdn
+{
+	// function package for sax_parser, errors of decoder, lexer and parser are passed to handler.on_error,
+	// other functions are same as default_function_package.
+	template <typename char_t, concepts::sax_handler<char_t> handler_t>
+	class sax_function_package : public default_function_package<char_t>
+	{
+	public:
+		void handle_error(const pdn::error_message& msg)
+		{
+			handler_ptr->on_error(msg);
+		}
+		explicit sax_function_package(handler_t& handler) : handler_ptr{ &handler } {}
+	private:
+		handler_t* handler_ptr{};
+	};
+
+	// parser reports document by events of handler instead of building entity,
+	// memory used is O(depth of document) except values being reported.
+	// document is the implicit root object, its definitions are reported by on_key without on_begin_object and on_end.
+	// grammar, casting and errors are same as parser, except that redefinition of entity is not detected
+	// (it requires all names of object), every definition is reported in order of source.
+	// lists and objects are parsed by recursion, their nesting is limited by max nesting depth as parser.
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::function_package_for_parser<char_t> function_package,
+	          concepts::sax_handler<char_t>                 handler_t>
+	class sax_parser
+	{
+	public:
+		using char_type    = char_t;
+		using handler_type = handler_t;
+		using entity_type  = entity<char_type>;
+	private:
+		using syn_ec    = syntax_error_code;
+		using core_type = parser<char_type, function_package>;
+	public:
+		void parse(concepts::token_iterator<char_t> auto begin, auto end)
+		{
+			using enum pdn_token_code;
+			parse_start(begin, end);
+			assert(core.tk.code == eof && "parse terminated");
+		}
+		sax_parser(function_package& function_pkg, handler_type& handler) : core{ function_pkg }, handler_ptr{ &handler } {}
+	private:
+		void parse_start(auto& begin, auto end)
+		{
+			using enum pdn_token_code;
+			using parser_utility::is_expr_first;
+			using parser_utility::to_raw_error_token;
+
+			for (core.update_token(begin, end); core.tk.code != eof; )
+			{
+				if (core.tk.code == identifier)
+				{
+					emit_key();
+					parse_decl(begin, end);
+				}
+				else if (core.tk.code == semicolon)
+				{
+					core.update_token(begin, end);
+				}
+				else if (is_expr_first(core.tk.code))
+				{
+					core.post_err(core.tk.position, syn_ec::expect_entity_name, to_raw_error_token(core.tk));
+					discard_expr(begin, end);
+				}
+				else
+				{
+					core.post_err(core.tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(core.tk));
+					core.update_token(begin, end);
+				}
+			}
+		}
+
+		void parse_decl(auto& begin, auto end)
+		{
+			// ... iden CURPOS ...
+			// expect : | expr
+
+			using enum pdn_token_code;
+			using parser_utility::is_expr_first;
+			using parser_utility::default_entity_value;
+
+			type_code type_c = type_code::unknown;
+			auto type_pos = core.tk.position;
+
+			core.update_token(begin, end);
+			if (core.tk.code == colon)
+			{
+				core.update_token(begin, end);
+				type_pos = core.tk.position;
+
+				if (core.tk.code == identifier)
+				{
+					type_c = core.parse_type_spec();
+					core.update_token(begin, end);
+				}
+			}
+
+			if (!is_expr_first(core.tk.code))
+			{
+				core.post_err(core.tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(core.tk));
+				emit_entity(default_entity_value<char_t>(type_c), core.tk.position);
+				return;
+			}
+
+			auto value_pos = core.tk.position;
+			emit_value(parse_expr(begin, end, type_c), type_c, type_pos, value_pos);
+		}
+
+		// parses expression, containers are reported while they are parsed,
+		// returns value waiting for casting and reporting, nullopt if it was reported already.
+		auto parse_expr(auto& begin, auto end, type_code type_c) -> ::std::optional<entity_type>
+		{
+			using enum pdn_token_code;
+			using parser_utility::default_entity_value;
+
+			auto unary_rec = core.process_unary_operation(begin, end);
+
+			if (core.tk.code == left_brackets || core.tk.code == left_curly_brackets)
+			{
+				const auto container_c = core.tk.code == left_brackets ? type_code::list : type_code::object;
+				if (depth >= core.max_nesting_depth())
+				{
+					// empty container stands for the one nested too deep, it is casted and reported as other values
+					core.post_err(core.tk.position, syn_ec::nesting_too_deep, {});
+					core.skip_container(begin, end);
+					auto stand_in = default_entity_value<char_t>(container_c);
+					core.apply_unary_operation(stand_in, unary_rec);
+					return stand_in;
+				}
+				// container casted to other type is replaced by default value, its events are dropped
+				const bool dropped = type_c != type_code::unknown && type_c != container_c;
+				const auto open_pos = core.tk.position;
+				if (dropped)
+				{
+					++muted_depth;
+				}
+				core.update_token(begin, end);
+				++depth;
+				if (container_c == type_code::list)
+				{
+					parse_list_expr(begin, end, open_pos);
+				}
+				else
+				{
+					parse_object_expr(begin, end, open_pos);
+				}
+				--depth;
+				if (dropped)
+				{
+					--muted_depth;
+				}
+				if (!unary_rec.has_sign && !dropped)
+				{
+					return ::std::nullopt;
+				}
+				// empty container stands for the parsed one, errors of unary operation and casting do not use its content
+				auto stand_in = default_entity_value<char_t>(container_c);
+				core.apply_unary_operation(stand_in, unary_rec);
+				return dropped ? ::std::optional<entity_type>{ ::std::move(stand_in) } : ::std::nullopt;
+			}
+
+			if (!parser_utility::is_expr_first(core.tk.code))
+			{
+				core.post_err(core.tk.position, syn_ec::expect_expression, parser_utility::to_raw_error_token(core.tk));
+				return entity_type{ type::auto_int{} };
+			}
+
+			auto result = core.parse_expr_without_unary(begin, end);
+			core.apply_unary_operation(result, unary_rec);
+			return result;
+		}
+
+		void discard_expr(auto& begin, auto end)
+		{
+			++muted_depth;
+			parse_expr(begin, end, type_code::unknown);
+			--muted_depth;
+		}
+
+		void parse_list_expr(auto& begin, auto end, source_position left_brackets_pos)
+		{
+			// ... [ CURRPOS ...
+
+			using parser_utility::is_list_element_first;
+			using parser_utility::to_raw_error_token;
+
+			emit([&](handler_type& handler) { handler.on_begin_list(left_brackets_pos); });
+
+			for (bool with_comma{ true }; core.tk.code != pdn_token_code::right_brackets; )
+			{
+				if (core.tk.code == pdn_token_code::eof)
+				{
+					core.post_err(left_brackets_pos, syn_ec::missing_right_brackets, {});
+					emit([&](handler_type& handler) { handler.on_end(core.tk.position); });
+					return;
+				}
+				if (is_list_element_first(core.tk.code))
+				{
+					if (!with_comma)
+					{
+						core.post_err(core.tk.position, syn_ec::expect_comma, to_raw_error_token(core.tk));
+					}
+					parse_list_element(begin, end, with_comma);
+				}
+				else
+				{
+					core.post_err(core.tk.position, syn_ec::expect_definition_of_list_element, to_raw_error_token(core.tk));
+					core.update_token(begin, end);
+				}
+			}
+
+			// to ... [ ... ] CURRPOS
+			emit([&](handler_type& handler) { handler.on_end(core.tk.position); });
+			core.update_token(begin, end);
+		}
+
+		void parse_list_element(auto& begin, auto end, bool& with_comma)
+		{
+			// ... iden [colon [typename] ] [ ... ] CURPOS ...
+
+			auto type_c = type_code::unknown;
+			auto type_pos = core.tk.position;
+
+			if (core.tk.code == pdn_token_code::identifier)
+			{
+				type_c = core.parse_type_spec();
+				core.update_token(begin, end);
+				if (core.tk.code == pdn_token_code::colon)
+				{
+					core.update_token(begin, end);
+				}
+				else
+				{
+					core.post_err(core.tk.position, syn_ec::expect_colon, parser_utility::to_raw_error_token(core.tk));
+				}
+			}
+
+			auto value_pos = core.tk.position;
+			auto value = parse_expr(begin, end, type_c);
+			// to ... [ (element,)* element CURRPOS ...
+
+			if (core.tk.code == pdn_token_code::comma)
+			{
+				core.update_token(begin, end);
+				with_comma = true;
+			}
+			else
+			{
+				with_comma = false;
+			}
+
+			emit_value(::std::move(value), type_c, type_pos, value_pos);
+		}
+
+		void parse_object_expr(auto& begin, auto end, source_position left_curly_brackets_pos)
+		{
+			// ... { CURRPOS ...
+
+			using parser_utility::is_expr_first;
+			using parser_utility::to_raw_error_token;
+
+			emit([&](handler_type& handler) { handler.on_begin_object(left_curly_brackets_pos); });
+
+			while (core.tk.code != pdn_token_code::right_curly_brackets)
+			{
+				if (core.tk.code == pdn_token_code::identifier)
+				{
+					emit_key();
+					parse_decl(begin, end);
+				}
+				else if (core.tk.code == pdn_token_code::semicolon)
+				{
+					core.update_token(begin, end);
+				}
+				else if (is_expr_first(core.tk.code))
+				{
+					core.post_err(core.tk.position, syn_ec::expect_entity_name, to_raw_error_token(core.tk));
+					discard_expr(begin, end);
+				}
+				else if (core.tk.code == pdn_token_code::eof)
+				{
+					core.post_err(left_curly_brackets_pos, syn_ec::missing_right_curly_brackets, {});
+					emit([&](handler_type& handler) { handler.on_end(core.tk.position); });
+					return;
+				}
+				else
+				{
+					core.post_err(core.tk.position, syn_ec::expect_definition_of_named_entity, to_raw_error_token(core.tk));
+					core.update_token(begin, end);
+				}
+			}
+
+			// to ... { ... } CURRPOS
+			emit([&](handler_type& handler) { handler.on_end(core.tk.position); });
+			core.update_token(begin, end);
+		}
+
+		void emit(auto&& event)
+		{
+			if (muted_depth == 0)
+			{
+				event(*handler_ptr);
+			}
+		}
+
+		void emit_key()
+		{
+			using string_pr = proxy<type::string<char_t>>;
+			const auto& iden = *::std::get<string_pr>(core.tk.value);
+			emit([&](handler_type& handler) { handler.on_key(::std::basic_string_view<char_t>{ iden }, core.tk.position); });
+		}
+
+		void emit_value(::std::optional<entity_type> value, type_code type_c, source_position type_pos, source_position value_pos)
+		{
+			if (!value)
+			{
+				return;
+			}
+			if (type_c != type_code::unknown)
+			{
+				*value = core.entity_cast(::std::move(*value), type_c, type_pos);
+			}
+			emit_entity(*value, value_pos);
+		}
+
+		// reports value of entity, containers (such as constants or default values) are reported recursively
+		void emit_entity(const entity_type& e, source_position pos)
+		{
+			if (muted_depth != 0)
+			{
+				return;
+			}
+			::std::visit([&](const auto& arg)
+			{
+				using arg_t = ::std::decay_t<decltype(arg)>;
+				auto& handler = *handler_ptr;
+				if constexpr (::std::same_as<arg_t, proxy<type::string<char_t>>>)
+				{
+					handler.on_value(::std::basic_string_view<char_t>{ *arg }, pos);
+				}
+				else if constexpr (::std::same_as<arg_t, proxy<type::list<char_t>>>)
+				{
+					handler.on_begin_list(pos);
+					for (const auto& element : *arg)
+					{
+						emit_entity(element, pos);
+					}
+					handler.on_end(pos);
+				}
+				else if constexpr (::std::same_as<arg_t, proxy<type::packed_list>>)
+				{
+					handler.on_begin_list(pos);
+					arg->visit([&](auto elements)
+					{
+						for (auto element : elements)
+						{
+							handler.on_value(element, pos);
+						}
+					});
+					handler.on_end(pos);
+				}
+				else if constexpr (::std::same_as<arg_t, proxy<type::object<char_t>>>)
+				{
+					handler.on_begin_object(pos);
+					for (const auto& [name, member] : *arg)
+					{
+						handler.on_key(::std::basic_string_view<char_t>{ name }, pos);
+						emit_entity(member, pos);
+					}
+					handler.on_end(pos);
+				}
+				else
+				{
+					handler.on_value(arg, pos);
+				}
+			}, e);
+		}
+	private:
+		core_type     core;             // grammar of values, current token and function package
+		handler_type* handler_ptr{};
+		::std::size_t muted_depth{};    // events are dropped while it is not 0
+		::std::size_t depth{};          // count of opened lists and objects
+	};
+
+	template <unicode::concepts::code_unit                  char_t,
+	          concepts::function_package_for_parser<char_t> function_package,
+	          concepts::sax_handler<char_t>                 handler_t>
+	inline auto make_sax_parser(function_package& function_pkg, handler_t& handler, char_t = {})
+	{
+		return sax_parser<char_t, function_package, handler_t>{ function_pkg, handler };
+	}
+}
+
+#endif
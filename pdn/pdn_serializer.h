@@ -210,6 +210,21 @@ namespace pdn
 			if (use_last_sep_for_lo) result += last_sep;
 			return result;
 		}
+		// packed list as list of its elements
+		template <typename src_char_t>
+		auto serialize(
+			const type::string<src_char_t>& iden,
+			const type::packed_list& val,
+			const ::std::size_t layer = 0,
+			const bool use_line_feed = true,
+			const bool use_last_sep_for_lo = true) const -> string_t
+		{
+			string_t result = serialize_iden(iden);
+			result += list_separator;
+			result += serialize_list(val, layer, use_line_feed, use_last_sep_for_lo);
+			if (use_last_sep_for_lo) result += last_sep;
+			return result;
+		}
 		// identifier to "[`]slashed[`]"
 		template <typename src_char_t>
 		auto serialize_iden(const type::string<src_char_t>& iden) const -> string_t
@@ -294,12 +309,13 @@ namespace pdn
 		// object member to "name [:[type]] value [;]..."
 		template <typename src_char_t>
 		auto serialize_object_member(
-			const type::string<src_char_t>& iden,
+			const type::object_key<src_char_t>& key,
 			const entity<src_char_t>& val,
 			const ::std::size_t layer,
 			const bool use_line_feed = true,
 			const bool use_last_sep_for_lo = true) const -> string_t
 		{
+			const type::string<src_char_t>& iden = key;
 			return ::std::visit([&]<typename arg_pr_t>(const arg_pr_t& arg) -> string_t
 			{
 				using arg_t = remove_proxy_t<arg_pr_t>;
@@ -323,31 +339,25 @@ namespace pdn
 			const bool use_line_feed = true,
 			const bool use_last_sep_for_lo = true) const -> string_t
 		{
-			string_t result{ char_t('[') };
-			if (val.empty())
+			return serialize_elements(val, layer, use_line_feed, [&](const entity<src_char_t>& e)
 			{
-				result += char_t(']');
-				return result;
-			}
-			const auto inner_layer = layer + 1;
-			for (const auto& e : val)
+				return serialize_list_element(e, layer + 1, use_line_feed, use_last_sep_for_lo);
+			});
+		}
+		// packed list to "[ ..., ]", same as list of its elements
+		auto serialize_list(
+			const type::packed_list& val,
+			const ::std::size_t layer,
+			const bool use_line_feed = true,
+			const bool = true) const -> string_t
+		{
+			return val.visit([&](auto elements)
 			{
-				if (use_line_feed)
+				return serialize_elements(elements, layer, use_line_feed, [&](auto e)
 				{
-					result += char_t('\n');
-					result += gen_tabs(inner_layer);
-				}
-				result += serialize_list_element(e, inner_layer, use_line_feed, use_last_sep_for_lo);
-				result += char_t(',');
-				if (!use_line_feed) result += char_t(' ');
-			}
-			if (use_line_feed)
-			{
-				result += char_t('\n');
-				result += gen_tabs(layer);
-			}
-			result += char_t(']');
-			return result;
+					return serialize_element_value<char_t>(e);
+				});
+			});
 		}
 		// list element to "[type:] pdn_form,"
 		template <typename src_char_t>
@@ -364,7 +374,7 @@ namespace pdn
 				{
 					return serialize_object(*arg, layer, use_line_feed, use_last_sep_for_lo);
 				}
-				else if constexpr (::std::same_as<arg_t, type::list<src_char_t>>)
+				else if constexpr (::std::same_as<arg_t, type::list<src_char_t>> || ::std::same_as<arg_t, type::packed_list>)
 				{
 					return serialize_list(*arg, layer, use_line_feed, use_last_sep_for_lo);
 				}
@@ -374,29 +384,64 @@ namespace pdn
 				}
 				else
 				{
-					string_t result{};
-					constexpr auto no_type_spec
-						 = ::std::same_as<arg_t, type::auto_int>
-						|| ::std::same_as<arg_t, type::f64>
-						|| ::std::same_as<arg_t, type::boolean>
-						|| ::std::same_as<arg_t, type::character<src_char_t>>
-						|| ::std::same_as<arg_t, type::string<src_char_t>>;
-					if constexpr (no_type_spec)
-					{
-						result += serialize_value<src_char_t>(arg);
-					}
-					else
-					{
-						constexpr auto type_c = type_to_type_code_v<arg_t, src_char_t>;
-						result += unicode::code_convert<string_t>(type_code_to_error_msg_string(type_c));
-						result += separator_for_ts;
-						result += serialize_value<src_char_t>(arg);
-					}
-					return result;
+					return serialize_element_value<src_char_t>(arg);
 				}
 			}, val);
 		}
 	private:
+		// basic value in list to "[type:] pdn_form"
+		template <typename src_char_t, typename value_t>
+		auto serialize_element_value(const value_t& val) const -> string_t
+		{
+			string_t result{};
+			constexpr auto no_type_spec
+				 = ::std::same_as<value_t, type::auto_int>
+				|| ::std::same_as<value_t, type::f64>
+				|| ::std::same_as<value_t, type::boolean>
+				|| ::std::same_as<value_t, type::character<src_char_t>>
+				|| ::std::same_as<value_t, type::string<src_char_t>>;
+			if constexpr (no_type_spec)
+			{
+				result += serialize_value<src_char_t>(val);
+			}
+			else
+			{
+				constexpr auto type_c = type_to_type_code_v<value_t, src_char_t>;
+				result += unicode::code_convert<string_t>(type_code_to_error_msg_string(type_c));
+				result += separator_for_ts;
+				result += serialize_value<src_char_t>(val);
+			}
+			return result;
+		}
+		// elements to "[ ..., ]", each element to pdn_form by serialize_element
+		auto serialize_elements(const auto& elements, const ::std::size_t layer, const bool use_line_feed, auto serialize_element) const -> string_t
+		{
+			string_t result{ char_t('[') };
+			if (elements.empty())
+			{
+				result += char_t(']');
+				return result;
+			}
+			const auto inner_layer = layer + 1;
+			for (const auto& e : elements)
+			{
+				if (use_line_feed)
+				{
+					result += char_t('\n');
+					result += gen_tabs(inner_layer);
+				}
+				result += serialize_element(e);
+				result += char_t(',');
+				if (!use_line_feed) result += char_t(' ');
+			}
+			if (use_line_feed)
+			{
+				result += char_t('\n');
+				result += gen_tabs(layer);
+			}
+			result += char_t(']');
+			return result;
+		}
 		auto gen_tabs(::std::size_t layer) const -> string_t
 		{
 			string_t result{};
@@ -0,0 +1,85 @@
+#ifndef PDN_Header_pdn_source_locator
+#define PDN_Header_pdn_source_locator
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "pdn_unicode_base.h"
+#include "pdn_convert_decision.h"
+#include "pdn_source_position.h"
+#include "pdn_source_position_recorder.h"
+
+namespace pdn::detail
+{
+	// finds code units of code points by their positions in contiguous source,
+	// code points are decoded as code point iterator does and their positions are counted from where it starts.
+	// it moves forward only, so positions should be found in increasing order.
+	template <unicode::concepts::code_unit unit_t>
+	class source_locator
+	{
+	public:
+		using source_type = ::std::basic_string_view<unit_t>;
+		using size_type   = ::std::size_t;
+	private:
+		using decision    = unicode::convert_decision<source_type, unicode::ucpstring>;
+	public:
+		// offset of first code unit of code point at pos, nullopt if no code point is at pos.
+		// LF following CR shares position with the next code point, it is never found.
+		auto find(source_position pos) -> ::std::optional<size_type>
+		{
+			while (it != last)
+			{
+				const auto unit_it = it;
+				auto c = static_cast<unicode::code_point_t>(*it);
+				if (c >= 0x80)
+				{
+					auto result = decision::template decode<false>(it, last);
+					if (!result)
+					{
+						// malformed sequence makes no code point
+						if (it != last && !decision::decoder_type::template is_reaching_next<false>(result))
+						{
+							++it;
+						}
+						continue;
+					}
+					c = result.value();
+				}
+				const auto current = pos_recorder.position();
+				if (current.line > pos.line || (current.line == pos.line && current.column >= pos.column))
+				{
+					if (current == pos && !(c == U'\n' && is_last_cr))
+					{
+						it = unit_it;
+						return static_cast<size_type>(unit_it - first);
+					}
+					if (current != pos)
+					{
+						it = unit_it;
+						return ::std::nullopt;
+					}
+				}
+				pos_recorder.update(c);
+				is_last_cr = c == U'\r';
+				++it;
+			}
+			return ::std::nullopt;
+		}
+
+		// offset is where code point iterator starts, start is position of code point there
+		source_locator(source_type source, size_type offset, source_position start) :
+			first       { source.data() },
+			last        { source.data() + source.size() },
+			it          { source.data() + offset },
+			pos_recorder{ start } {}
+	private:
+		const unit_t*            first{};
+		const unit_t*            last{};
+		const unit_t*            it{};
+		source_position_recorder pos_recorder{};
+		bool                     is_last_cr{};
+	};
+}
+
+#endif
@@ -10,6 +10,9 @@ namespace pdn
 	class source_position_recorder
 	{
 	public:
+		constexpr source_position_recorder() noexcept = default;
+		// starts from position other than beginning of source, such as the middle of document parsed again
+		constexpr explicit source_position_recorder(source_position start) noexcept : pos{ start } {}
 		constexpr source_position position() const noexcept
 		{
 			return pos;
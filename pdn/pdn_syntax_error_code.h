@@ -25,6 +25,8 @@ namespace pdn
 
 		missing_right_brackets,
 		missing_right_curly_brackets,
+
+		nesting_too_deep, // list or object is nested deeper than max nesting depth
 	};
 }
 
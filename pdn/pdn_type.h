@@ -3,18 +3,20 @@
 
 #include "pdn_type_basic.h"
 #include "pdn_type_config.h"
+#include "pdn_packed_list.h"
 #include "pdn_unicode_base.h"
 #include "pdn_entity_forward_decl.h"
 
 namespace pdn::type
 {
 	using config::string;
+	using config::object_key;
 
 	template <typename char_t>
 	using list = config::list<entity<char_t>>;
 
 	template <typename char_t>
-	using object = config::object<string<char_t>, entity<char_t>>;
+	using object = config::object<object_key<char_t>, entity<char_t>>;
 
 	using u8char  = character<unicode::u8char_t>;
 	using u16char = character<unicode::u16char_t>;
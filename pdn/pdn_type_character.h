@@ -38,7 +38,7 @@ namespace pdn::type::detail
 				*it = *first;
 			}
 		}
-		constexpr character(const character& rhs) : cont{ rhs.cont }, sz{ rhs.sz } {}
+		constexpr character(const character& rhs) noexcept : cont{ rhs.cont }, sz{ rhs.sz } {}
 		constexpr character& operator= (const character& rhs) noexcept = default;
 		constexpr auto data() const noexcept -> const_pointer
 		{
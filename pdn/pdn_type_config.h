@@ -9,9 +9,10 @@
 
 #include "pdn_unicode_base.h"
 #include "pdn_type_character.h"
-
-// keep the order in parse
-// #include "pdn_ordered_map.h"
+#include "pdn_memory_resource.h"
+#include "pdn_ordered_map.h"
+#include "pdn_flat_map.h"
+#include "pdn_key_intern.h"
 
 namespace pdn::type::config
 {
@@ -33,11 +34,40 @@ namespace pdn::type::config
 	template <typename char_t>
 	using character = detail::character<char_t>;
 
+#if defined(PDN_Macro_entity_memory_resource)
+	// defined before including pdn, strings, lists and objects allocate from current_memory_resource() when they are made,
+	// so document parsed in memory_resource_scope is made in the given resource, see arena_document.
+	inline constexpr bool entity_memory_resource = true;
+
+	template <typename char_t>
+	using string = ::std::basic_string<char_t, ::std::char_traits<char_t>, resource_allocator<char_t>>;
+	
+	template <typename entity_t>
+	using list = ::std::vector<entity_t, resource_allocator<entity_t>>;
+
+	template <typename t>
+	using packed_allocator = resource_allocator<t>;
+#else
+	inline constexpr bool entity_memory_resource = false;
+
 	template <typename char_t>
 	using string = ::std::basic_string<char_t>;
 	
 	template <typename entity_t>
 	using list = ::std::vector<entity_t>;
+
+	template <typename t>
+	using packed_allocator = ::std::allocator<t>;
+#endif
+
+#if defined(PDN_Macro_pack_lists)
+	// defined before including pdn, parser holds list whose elements are all of one integral, floating point or boolean type
+	// as type::packed_list, array of that type viewed by as_span<T>(), instead of list of entities,
+	// such as list of f64 made by type spec of its elements. list is unpacked when element of other type is stored into it.
+	inline constexpr bool pack_lists = true;
+#else
+	inline constexpr bool pack_lists = false;
+#endif
 	
 	struct key_hasher
 	{
@@ -58,14 +88,62 @@ namespace pdn::type::config
 		{
 			return ::std::hash<u32sv>{}(sv);
 		}
+		template <typename char_t>
+		auto operator()(const interned_key<char_t>& key) const noexcept -> ::std::size_t
+		{
+			return key.hash(); // computed once when text is interned
+		}
 	};
 
-	template <typename iden_t, typename entity_t>
-	using object = ::std::unordered_map<iden_t, entity_t, key_hasher, ::std::equal_to<>>;
+#if defined(PDN_Macro_intern_object_keys)
+#	if defined(PDN_Macro_entity_memory_resource)
+#		error "[pdn] PDN_Macro_intern_object_keys and PDN_Macro_entity_memory_resource cannot be defined together"
+#	endif
+	// defined before including pdn, keys of objects are interned_key, keys made in key_table_scope share their text,
+	// so documents parsed in the scope hold each distinct key once.
+	inline constexpr bool intern_object_keys = true;
 
-	// keep the order in parse
-	// template <typename iden_t, typename entity_t>
-	// using object = detail::ordered_map<iden_t, entity_t>;
+	template <typename char_t>
+	using object_key = interned_key<char_t>;
+#else
+	inline constexpr bool intern_object_keys = false;
+
+	template <typename char_t>
+	using object_key = string<char_t>;
+#endif
+
+#if defined(PDN_Macro_keep_object_order) && defined(PDN_Macro_flat_object_map)
+#	error "[pdn] PDN_Macro_keep_object_order and PDN_Macro_flat_object_map cannot be defined together"
+#endif
+
+#if defined(PDN_Macro_keep_object_order)
+	// defined before including pdn, objects keep their entities in order of parse (or insertion),
+	// so they are serialized in that order.
+	inline constexpr bool keep_object_order = true;
+
+	template <typename iden_t, typename entity_t, typename alloc_t>
+	using object_map = detail::ordered_map<iden_t, entity_t, key_hasher, ::std::equal_to<>, alloc_t>;
+#elif defined(PDN_Macro_flat_object_map)
+	// defined before including pdn, objects hold their entities in flat hash map instead of nodes,
+	// so they allocate less and find entities by touching fewer cache lines, order of entities is unspecified.
+	inline constexpr bool keep_object_order = false;
+
+	template <typename iden_t, typename entity_t, typename alloc_t>
+	using object_map = detail::flat_map<iden_t, entity_t, key_hasher, ::std::equal_to<>, alloc_t>;
+#else
+	inline constexpr bool keep_object_order = false;
+
+	template <typename iden_t, typename entity_t, typename alloc_t>
+	using object_map = ::std::unordered_map<iden_t, entity_t, key_hasher, ::std::equal_to<>, alloc_t>;
+#endif
+
+#if defined(PDN_Macro_entity_memory_resource)
+	template <typename iden_t, typename entity_t>
+	using object = object_map<iden_t, entity_t, resource_allocator<::std::pair<const iden_t, entity_t>>>;
+#else
+	template <typename iden_t, typename entity_t>
+	using object = object_map<iden_t, entity_t, ::std::allocator<::std::pair<const iden_t, entity_t>>>;
+#endif
 }
 
 #endif
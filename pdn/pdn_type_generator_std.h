@@ -2,6 +2,8 @@
 #define PDN_Header_pdn_type_generator_std
 
 #include <unordered_map>
+#include <functional>
+#include <string_view>
 
 #include "pdn_type.h"
 #include "pdn_type_code.h"
@@ -109,7 +111,7 @@ namespace pdn
 		static_assert(false, "[pdn] cannot generate type_table for template parameter \"char_t\"");
 	};
 	template <>
-	class type_table<unicode::u8char_t> : public ::std::unordered_map<type::string<unicode::u8char_t>, type_code>
+	class type_table<unicode::u8char_t> : public ::std::unordered_map<unicode::u8string, type_code, type::config::key_hasher, ::std::equal_to<>>
 	{
 	public:
 		type_table()
@@ -121,7 +123,7 @@ namespace pdn
 		}
 	};
 	template <>
-	class type_table<unicode::u16char_t> : public ::std::unordered_map<type::string<unicode::u16char_t>, type_code>
+	class type_table<unicode::u16char_t> : public ::std::unordered_map<unicode::u16string, type_code, type::config::key_hasher, ::std::equal_to<>>
 	{
 	public:
 		type_table()
@@ -133,7 +135,7 @@ namespace pdn
 		}
 	};
 	template <>
-	class type_table<unicode::u32char_t> : public ::std::unordered_map<type::string<unicode::u32char_t>, type_code>
+	class type_table<unicode::u32char_t> : public ::std::unordered_map<unicode::u32string, type_code, type::config::key_hasher, ::std::equal_to<>>
 	{
 	public:
 		type_table()
@@ -151,7 +153,7 @@ namespace pdn
 	type_code type_generator_function(const type::string<char_t>& s)
 	{
 		static type_table<char_t> table{};
-		if (auto result = table.find(s); result != table.end())
+		if (auto result = table.find(::std::basic_string_view<char_t>{ s }); result != table.end())
 		{
 			return result->second;
 		}
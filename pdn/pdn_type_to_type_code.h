@@ -86,6 +86,12 @@ namespace pdn
 	{
 		static constexpr type_code value = type_code::object;
 	};
+	// packed list is list of its elements
+	template <typename char_t>
+	struct type_to_type_code<type::packed_list, char_t>
+	{
+		static constexpr type_code value = type_code::list;
+	};
 	template <typename type, typename char_t>
 	inline constexpr type_code type_to_type_code_v = type_to_type_code<type, char_t>::value;
 }
@@ -0,0 +1,535 @@
+#ifndef PDN_Header_pdn_unicode_simd
+#define PDN_Header_pdn_unicode_simd
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define PDN_Macro_unicode_simd_x86_64
+#	include <immintrin.h>
+#	if defined(_MSC_VER) && !defined(__clang__)
+#		include <intrin.h>
+#		define PDN_Macro_unicode_simd_target_avx2
+#	else
+#		define PDN_Macro_unicode_simd_target_avx2 __attribute__((target("avx2")))
+#	endif
+#endif
+
+#include "pdn_unicode_base.h"
+
+// vectorized helpers for decoders,
+// instruction set is chosen at runtime, scalar implementation is used on other platforms.
+
+namespace pdn::unicode::simd
+{
+	enum class instruction_set
+	{
+		scalar,
+		sse2,
+		avx2,
+	};
+
+	inline auto detect_instruction_set() noexcept -> instruction_set
+	{
+#if defined(PDN_Macro_unicode_simd_x86_64)
+#	if defined(_MSC_VER) && !defined(__clang__)
+		int info[4]{};
+		::__cpuid(info, 0);
+		if (info[0] >= 7)
+		{
+			::__cpuid(info, 1);
+			const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (::_xgetbv(0) & 0x6) == 0x6; // OSXSAVE, XMM and YMM state
+			::__cpuidex(info, 7, 0);
+			if (os_saves_ymm && (info[1] & (1 << 5)) != 0) // AVX2
+			{
+				return instruction_set::avx2;
+			}
+		}
+#	else
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return instruction_set::avx2;
+		}
+#	endif
+		return instruction_set::sse2; // sse2 is baseline of x86-64
+#else
+		return instruction_set::scalar;
+#endif
+	}
+
+	inline auto supported_instruction_set() noexcept -> instruction_set
+	{
+		static const instruction_set result = detect_instruction_set();
+		return result;
+	}
+}
+
+namespace pdn::unicode::simd::detail
+{
+	template <typename char_t>
+	inline auto ascii_prefix_length_scalar(const char_t* begin, ::std::size_t size) noexcept -> ::std::size_t
+	{
+		::std::size_t count{};
+		if constexpr (sizeof(char_t) == 1)
+		{
+			constexpr ::std::uint64_t high_bits{ 0x8080'8080'8080'8080u };
+			for (; size - count >= 8; count += 8)
+			{
+				::std::uint64_t word{};
+				::std::memcpy(&word, begin + count, 8);
+				if ((word & high_bits) != 0)
+				{
+					break;
+				}
+			}
+		}
+		for (; count < size && ::std::uint_least32_t(begin[count]) < 0x80u; ++count);
+		return count;
+	}
+
+	template <typename source_char_t, typename target_char_t>
+	inline void convert_ascii_scalar(const source_char_t* source, ::std::size_t count, target_char_t* target) noexcept
+	{
+		for (::std::size_t i{}; i < count; ++i)
+		{
+			target[i] = target_char_t(source[i]);
+		}
+	}
+
+	inline auto decode_ascii_prefix_scalar(const u8char_t* begin, ::std::size_t limit, code_point_t* out) noexcept -> ::std::size_t
+	{
+		constexpr ::std::uint64_t high_bits{ 0x8080'8080'8080'8080u };
+		::std::size_t count{};
+		for (; limit - count >= 8; count += 8)
+		{
+			::std::uint64_t word{};
+			::std::memcpy(&word, begin + count, 8);
+			if ((word & high_bits) != 0)
+			{
+				break;
+			}
+			for (::std::size_t i{}; i < 8; ++i)
+			{
+				out[count + i] = code_point_t(begin[count + i]);
+			}
+		}
+		for (; count < limit && begin[count] < 0x80u; ++count)
+		{
+			out[count] = code_point_t(begin[count]);
+		}
+		return count;
+	}
+
+	template <typename char_t>
+	inline auto byteswap_unit(char_t value) noexcept -> char_t
+	{
+		auto u = static_cast<::std::uint_least32_t>(value);
+		if constexpr (sizeof(char_t) == 2)
+		{
+			return char_t(((u & 0xFFu) << 8) | ((u >> 8) & 0xFFu));
+		}
+		else
+		{
+			return char_t(((u & 0xFFu) << 24) | ((u & 0xFF00u) << 8) | ((u >> 8) & 0xFF00u) | ((u >> 24) & 0xFFu));
+		}
+	}
+
+	template <typename char_t>
+	inline void byteswap_units_scalar(const unsigned char* source, ::std::size_t count, char_t* target) noexcept
+	{
+		for (::std::size_t i{}; i < count; ++i)
+		{
+			char_t unit{};
+			::std::memcpy(&unit, source + i * sizeof(char_t), sizeof(char_t));
+			target[i] = byteswap_unit(unit);
+		}
+	}
+
+	// code point is not unicode scalar value or is one of stops
+	template <::std::size_t n>
+	constexpr bool is_stop_code_point(code_point_t c, const code_point_t (&stops)[n]) noexcept
+	{
+		if ((c >= 0xD800u && c <= 0xDFFFu) || c > 0x10'FFFFu)
+		{
+			return true;
+		}
+		for (auto stop : stops)
+		{
+			if (c == stop)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <::std::size_t n>
+	inline auto find_code_point_scalar(const code_point_t* begin, ::std::size_t size, const code_point_t (&stops)[n]) noexcept -> ::std::size_t
+	{
+		::std::size_t i{};
+		while (i < size && !is_stop_code_point(begin[i], stops))
+		{
+			++i;
+		}
+		return i;
+	}
+
+#if defined(PDN_Macro_unicode_simd_x86_64)
+	// mask of non-ASCII code units of 16 bytes, one bit per byte
+	inline auto non_ascii_mask_sse2(const u8char_t* p) noexcept -> unsigned
+	{
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+	}
+	inline auto non_ascii_mask_sse2(const u16char_t* p) noexcept -> unsigned
+	{
+		const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const __m128i high  = _mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFF80)));
+		return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128()))) & 0xFFFFu;
+	}
+	inline auto non_ascii_mask_sse2(const u32char_t* p) noexcept -> unsigned
+	{
+		const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const __m128i high  = _mm_and_si128(units, _mm_set1_epi32(static_cast<int>(0xFFFF'FF80u)));
+		return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128()))) & 0xFFFFu;
+	}
+
+	template <typename char_t>
+	inline auto ascii_prefix_length_sse2(const char_t* begin, ::std::size_t size) noexcept -> ::std::size_t
+	{
+		constexpr ::std::size_t step{ 16 / sizeof(char_t) };
+		::std::size_t count{};
+		for (; size - count >= step; count += step)
+		{
+			if (auto mask = non_ascii_mask_sse2(begin + count); mask != 0)
+			{
+				return count + static_cast<::std::size_t>(::std::countr_zero(mask)) / sizeof(char_t);
+			}
+		}
+		return count + ascii_prefix_length_scalar(begin + count, size - count);
+	}
+
+	PDN_Macro_unicode_simd_target_avx2
+	inline auto ascii_prefix_length_avx2(const u8char_t* begin, ::std::size_t size) noexcept -> ::std::size_t
+	{
+		::std::size_t count{};
+		for (; size - count >= 32; count += 32)
+		{
+			const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + count));
+			if (auto mask = static_cast<unsigned>(_mm256_movemask_epi8(bytes)); mask != 0)
+			{
+				return count + static_cast<::std::size_t>(::std::countr_zero(mask));
+			}
+		}
+		return count + ascii_prefix_length_sse2(begin + count, size - count);
+	}
+
+	// converts 16 ASCII code units (or 8 for 32 bits to 32 bits) per step
+	template <typename source_char_t, typename target_char_t>
+	inline void convert_ascii_sse2(const source_char_t* source, ::std::size_t count, target_char_t* target) noexcept
+	{
+		constexpr auto src_size = sizeof(source_char_t);
+		constexpr auto des_size = sizeof(target_char_t);
+		const __m128i  zero     = _mm_setzero_si128();
+		auto load  = [](const void* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+		auto store = [](void* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); };
+		::std::size_t i{};
+		for (; count - i >= 16; i += 16)
+		{
+			if constexpr (src_size == 1 && des_size == 2)
+			{
+				const __m128i bytes = load(source + i);
+				store(target + i,     _mm_unpacklo_epi8(bytes, zero));
+				store(target + i + 8, _mm_unpackhi_epi8(bytes, zero));
+			}
+			else if constexpr (src_size == 1 && des_size == 4)
+			{
+				const __m128i bytes = load(source + i);
+				const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+				const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+				store(target + i,      _mm_unpacklo_epi16(lo, zero));
+				store(target + i + 4,  _mm_unpackhi_epi16(lo, zero));
+				store(target + i + 8,  _mm_unpacklo_epi16(hi, zero));
+				store(target + i + 12, _mm_unpackhi_epi16(hi, zero));
+			}
+			else if constexpr (src_size == 2 && des_size == 1)
+			{
+				store(target + i, _mm_packus_epi16(load(source + i), load(source + i + 8)));
+			}
+			else if constexpr (src_size == 2 && des_size == 4)
+			{
+				const __m128i lo = load(source + i);
+				const __m128i hi = load(source + i + 8);
+				store(target + i,      _mm_unpacklo_epi16(lo, zero));
+				store(target + i + 4,  _mm_unpackhi_epi16(lo, zero));
+				store(target + i + 8,  _mm_unpacklo_epi16(hi, zero));
+				store(target + i + 12, _mm_unpackhi_epi16(hi, zero));
+			}
+			else if constexpr (src_size == 4 && des_size == 1)
+			{
+				// values are less than 0x80, signed saturation keeps them
+				const __m128i lo = _mm_packs_epi32(load(source + i),     load(source + i + 4));
+				const __m128i hi = _mm_packs_epi32(load(source + i + 8), load(source + i + 12));
+				store(target + i, _mm_packus_epi16(lo, hi));
+			}
+			else if constexpr (src_size == 4 && des_size == 2)
+			{
+				store(target + i,     _mm_packs_epi32(load(source + i),     load(source + i + 4)));
+				store(target + i + 8, _mm_packs_epi32(load(source + i + 8), load(source + i + 12)));
+			}
+			else
+			{
+				::std::memcpy(target + i, source + i, 16 * src_size);
+			}
+		}
+		convert_ascii_scalar(source + i, count - i, target + i);
+	}
+
+	inline auto decode_ascii_prefix_sse2(const u8char_t* begin, ::std::size_t limit, code_point_t* out) noexcept -> ::std::size_t
+	{
+		const __m128i zero = _mm_setzero_si128();
+		::std::size_t count{};
+		for (; limit - count >= 16; count += 16)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + count));
+			const auto    mask  = static_cast<unsigned>(_mm_movemask_epi8(bytes));
+			// widen all 16 bytes, bytes after first non-ASCII one are overwritten later
+			const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count),      _mm_unpacklo_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 4),  _mm_unpackhi_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 8),  _mm_unpacklo_epi16(hi, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 12), _mm_unpackhi_epi16(hi, zero));
+			if (mask != 0)
+			{
+				return count + static_cast<::std::size_t>(::std::countr_zero(mask));
+			}
+		}
+		return count + decode_ascii_prefix_scalar(begin + count, limit - count, out + count);
+	}
+
+	PDN_Macro_unicode_simd_target_avx2
+	inline auto decode_ascii_prefix_avx2(const u8char_t* begin, ::std::size_t limit, code_point_t* out) noexcept -> ::std::size_t
+	{
+		::std::size_t count{};
+		for (; limit - count >= 32; count += 32)
+		{
+			const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + count));
+			const auto    mask  = static_cast<unsigned>(_mm256_movemask_epi8(bytes));
+			// widen all 32 bytes, bytes after first non-ASCII one are overwritten later
+			for (::std::size_t i{}; i < 32; i += 8)
+			{
+				const __m128i eight = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(begin + count + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count + i), _mm256_cvtepu8_epi32(eight));
+			}
+			if (mask != 0)
+			{
+				return count + static_cast<::std::size_t>(::std::countr_zero(mask));
+			}
+		}
+		return count + decode_ascii_prefix_sse2(begin + count, limit - count, out + count);
+	}
+
+	// sse2 has no byte shuffle, swaps bytes of 16-bit lanes by shifts, and 16-bit halves of 32-bit lanes by shuffle
+	template <typename char_t>
+	inline void byteswap_units_sse2(const unsigned char* source, ::std::size_t count, char_t* target) noexcept
+	{
+		constexpr ::std::size_t lane_count{ 16 / sizeof(char_t) };
+		::std::size_t i{};
+		for (; count - i >= lane_count; i += lane_count)
+		{
+			__m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * sizeof(char_t)));
+			if constexpr (sizeof(char_t) == 4)
+			{
+				units = _mm_shufflehi_epi16(_mm_shufflelo_epi16(units, 0xB1), 0xB1);
+			}
+			units = _mm_or_si128(_mm_slli_epi16(units, 8), _mm_srli_epi16(units, 8));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), units);
+		}
+		byteswap_units_scalar(source + i * sizeof(char_t), count - i, target + i);
+	}
+
+	template <typename char_t>
+	PDN_Macro_unicode_simd_target_avx2
+	inline void byteswap_units_avx2(const unsigned char* source, ::std::size_t count, char_t* target) noexcept
+	{
+		constexpr ::std::size_t lane_count{ 32 / sizeof(char_t) };
+		const __m256i order = sizeof(char_t) == 2
+			? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+			                   1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+			: _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			                   3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		::std::size_t i{};
+		for (; count - i >= lane_count; i += lane_count)
+		{
+			const __m256i units = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * sizeof(char_t)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_shuffle_epi8(units, order));
+		}
+		byteswap_units_sse2(source + i * sizeof(char_t), count - i, target + i);
+	}
+
+	// sse2 and avx2 have signed 32-bit comparison only, unsigned comparison is done by flipping sign bits
+	template <::std::size_t n>
+	inline auto find_code_point_sse2(const code_point_t* begin, ::std::size_t size, const code_point_t (&stops)[n]) noexcept -> ::std::size_t
+	{
+		const __m128i sign           = _mm_set1_epi32(static_cast<int>(0x8000'0000u));
+		const __m128i surrogate_min  = _mm_set1_epi32(0xD800);
+		const __m128i surrogate_span = _mm_set1_epi32(static_cast<int>(0x800u ^ 0x8000'0000u));
+		const __m128i scalar_max     = _mm_set1_epi32(static_cast<int>(0x10'FFFFu ^ 0x8000'0000u));
+		::std::size_t i{};
+		for (; size - i >= 4; i += 4)
+		{
+			const __m128i code_points = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+			__m128i hit = _mm_or_si128(
+				_mm_cmplt_epi32(_mm_xor_si128(_mm_sub_epi32(code_points, surrogate_min), sign), surrogate_span),
+				_mm_cmpgt_epi32(_mm_xor_si128(code_points, sign), scalar_max));
+			for (auto stop : stops)
+			{
+				hit = _mm_or_si128(hit, _mm_cmpeq_epi32(code_points, _mm_set1_epi32(static_cast<int>(stop))));
+			}
+			const auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+			if (mask != 0)
+			{
+				return i + static_cast<::std::size_t>(::std::countr_zero(mask));
+			}
+		}
+		return i + find_code_point_scalar(begin + i, size - i, stops);
+	}
+
+	template <::std::size_t n>
+	PDN_Macro_unicode_simd_target_avx2
+	inline auto find_code_point_avx2(const code_point_t* begin, ::std::size_t size, const code_point_t (&stops)[n]) noexcept -> ::std::size_t
+	{
+		const __m256i sign           = _mm256_set1_epi32(static_cast<int>(0x8000'0000u));
+		const __m256i surrogate_min  = _mm256_set1_epi32(0xD800);
+		const __m256i surrogate_span = _mm256_set1_epi32(static_cast<int>(0x800u ^ 0x8000'0000u));
+		const __m256i scalar_max     = _mm256_set1_epi32(static_cast<int>(0x10'FFFFu ^ 0x8000'0000u));
+		::std::size_t i{};
+		for (; size - i >= 8; i += 8)
+		{
+			const __m256i code_points = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i));
+			__m256i hit = _mm256_or_si256(
+				_mm256_cmpgt_epi32(surrogate_span, _mm256_xor_si256(_mm256_sub_epi32(code_points, surrogate_min), sign)),
+				_mm256_cmpgt_epi32(_mm256_xor_si256(code_points, sign), scalar_max));
+			for (auto stop : stops)
+			{
+				hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(code_points, _mm256_set1_epi32(static_cast<int>(stop))));
+			}
+			const auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+			if (mask != 0)
+			{
+				return i + static_cast<::std::size_t>(::std::countr_zero(mask));
+			}
+		}
+		return i + find_code_point_sse2(begin + i, size - i, stops);
+	}
+#endif
+}
+
+namespace pdn::unicode::simd
+{
+	// count of leading ASCII code units of [begin, end)
+	template <typename char_t>
+		requires (sizeof(char_t) == 1 || sizeof(char_t) == 2 || sizeof(char_t) == 4)
+	inline auto ascii_prefix_length(const char_t* begin, const char_t* end) noexcept -> ::std::size_t
+	{
+		const auto size = static_cast<::std::size_t>(end - begin);
+#if defined(PDN_Macro_unicode_simd_x86_64)
+		using unit_t = ::std::conditional_t<sizeof(char_t) == 1, u8char_t, ::std::conditional_t<sizeof(char_t) == 2, u16char_t, u32char_t>>;
+		auto units = reinterpret_cast<const unit_t*>(begin);
+		switch (supported_instruction_set())
+		{
+		case instruction_set::avx2:
+			if constexpr (sizeof(char_t) == 1)
+			{
+				return detail::ascii_prefix_length_avx2(units, size);
+			}
+			[[fallthrough]];
+		case instruction_set::sse2:
+			return detail::ascii_prefix_length_sse2(units, size);
+		default:
+			break;
+		}
+#endif
+		return detail::ascii_prefix_length_scalar(begin, size);
+	}
+
+	// converts count ASCII code units to code units of another encoding form, values are unchanged.
+	template <typename source_char_t, typename target_char_t>
+		requires (sizeof(source_char_t) == 1 || sizeof(source_char_t) == 2 || sizeof(source_char_t) == 4)
+		      && (sizeof(target_char_t) == 1 || sizeof(target_char_t) == 2 || sizeof(target_char_t) == 4)
+	inline void convert_ascii(const source_char_t* source, ::std::size_t count, target_char_t* target) noexcept
+	{
+		if constexpr (sizeof(source_char_t) == sizeof(target_char_t))
+		{
+			if (count != 0)
+			{
+				::std::memcpy(target, source, count * sizeof(target_char_t));
+			}
+		}
+		else
+		{
+#if defined(PDN_Macro_unicode_simd_x86_64)
+			detail::convert_ascii_sse2(source, count, target);
+#else
+			detail::convert_ascii_scalar(source, count, target);
+#endif
+		}
+	}
+
+	// decodes leading ASCII code units of [begin, end) into out, at most max_count of them.
+	// returns count of decoded code points, out must have room for max_count code points.
+	inline auto decode_ascii_prefix(const u8char_t* begin, const u8char_t* end, code_point_t* out, ::std::size_t max_count) noexcept -> ::std::size_t
+	{
+		const auto size  = static_cast<::std::size_t>(end - begin);
+		const auto limit = size < max_count ? size : max_count;
+#if defined(PDN_Macro_unicode_simd_x86_64)
+		switch (supported_instruction_set())
+		{
+		case instruction_set::avx2: return detail::decode_ascii_prefix_avx2(begin, limit, out);
+		case instruction_set::sse2: return detail::decode_ascii_prefix_sse2(begin, limit, out);
+		default:                    break;
+		}
+#endif
+		return detail::decode_ascii_prefix_scalar(begin, limit, out);
+	}
+
+	// reads count code units of opposite byte order from source bytes, stores them in native byte order.
+	// source has no alignment requirement.
+	template <typename char_t>
+		requires (sizeof(char_t) == 2 || sizeof(char_t) == 4)
+	inline void byteswap_units(const void* source, ::std::size_t count, char_t* target) noexcept
+	{
+		auto bytes = static_cast<const unsigned char*>(source);
+#if defined(PDN_Macro_unicode_simd_x86_64)
+		switch (supported_instruction_set())
+		{
+		case instruction_set::avx2: detail::byteswap_units_avx2(bytes, count, target); return;
+		case instruction_set::sse2: detail::byteswap_units_sse2(bytes, count, target); return;
+		default:                    break;
+		}
+#endif
+		detail::byteswap_units_scalar(bytes, count, target);
+	}
+
+	// index of first code point of [begin, end) which is one of stops or is not unicode scalar value,
+	// returns size of [begin, end) when there is no such code point.
+	template <::std::size_t n>
+	inline auto find_code_point(const code_point_t* begin, const code_point_t* end, const code_point_t (&stops)[n]) noexcept -> ::std::size_t
+	{
+		const auto size = static_cast<::std::size_t>(end - begin);
+#if defined(PDN_Macro_unicode_simd_x86_64)
+		switch (supported_instruction_set())
+		{
+		case instruction_set::avx2: return detail::find_code_point_avx2(begin, size, stops);
+		case instruction_set::sse2: return detail::find_code_point_sse2(begin, size, stops);
+		default:                    break;
+		}
+#endif
+		return detail::find_code_point_scalar(begin, size, stops);
+	}
+}
+
+#endif
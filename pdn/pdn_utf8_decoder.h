@@ -5,12 +5,14 @@
 #include <cstdint>
 #include <array>
 #include <utility>
+#include <cstddef>
 #ifndef __cpp_lib_unreachable
 #include <cassert>
 #endif
 
 #include "pdn_unicode_base.h"
 #include "pdn_utf8_base.h"
+#include "pdn_unicode_simd.h"
 
 namespace pdn::unicode::utf8
 {
@@ -167,6 +169,15 @@ namespace pdn::unicode::utf8
 		{
 			return decode_impl<reach_next_code_point>(begin, end);
 		}
+		// decodes leading ASCII code units into out (at most max_count of them) by vectorized scanning,
+		// begin moves past them. returns count of decoded code points.
+		// non-ASCII sequence should be decoded by decode, which reports exact error.
+		static auto decode_ascii(const code_unit_t*& begin, const code_unit_t* end, code_point_t* out, ::std::size_t max_count) noexcept -> ::std::size_t
+		{
+			const auto count = simd::decode_ascii_prefix(begin, end, out, max_count);
+			begin += count;
+			return count;
+		}
 	private:
 		template <bool reach_next_code_point>
 		static auto decode_impl(auto& begin, auto end) -> decode_result
@@ -234,7 +245,13 @@ namespace pdn::unicode::utf8
 				}
 			}
 
-			if constexpr (reach_next_code_point) { to_next(begin, result); }
+			if constexpr (reach_next_code_point)
+			{
+				if (begin != end) // begin is end already when eof was reached in sequence
+				{
+					to_next(begin, result);
+				}
+			}
 
 			return result;
 		}
@@ -4,9 +4,14 @@
 #include <string>
 #include <utility>
 #include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <cstddef>
 
 #include "pdn_unicode.h"
 #include "pdn_convert_decision.h"
+#include "pdn_unicode_simd.h"
 
 namespace pdn::unicode::detail
 {
@@ -29,6 +34,55 @@ namespace pdn::unicode::detail
 		return false;
 	}
 
+	// source is contiguous and target can be resized and written in place,
+	// so ASCII runs are converted in bulk and target is reserved by exact length
+	template <typename cvt_src, typename cvt_des>
+	concept bulk_convertible = requires(const cvt_src& source, cvt_des& target)
+	{
+		requires ::std::contiguous_iterator<decltype(::std::cbegin(source))>;
+		target.reserve(::std::size_t{});
+		target.resize(::std::size_t{});
+		{ target.data() } -> ::std::same_as<typename cvt_des::value_type*>;
+	};
+
+	template <typename char_t>
+	constexpr auto encoded_length(code_point_t c) noexcept -> ::std::size_t
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x1'0000 ? 3 : 4;
+		}
+		else if constexpr (sizeof(char_t) == 2)
+		{
+			return c < 0x1'0000 ? 1 : 2;
+		}
+		else
+		{
+			return 1;
+		}
+	}
+
+	// exact length of converted string, when malformed sequences are replaced by replacement character
+	template <typename decision, typename source_char_t>
+	inline auto converted_length(const source_char_t* begin, const source_char_t* end) -> ::std::size_t
+	{
+		using target_char = typename decision::target_char;
+		::std::size_t length{};
+		while (begin != end)
+		{
+			const auto ascii_count = simd::ascii_prefix_length(begin, end);
+			length += ascii_count;
+			begin  += ascii_count;
+			if (begin == end)
+			{
+				break;
+			}
+			auto decode_result = decision::template decode<true>(begin, end);
+			length += decode_result ? encoded_length<target_char>(decode_result.value()) : get_replace<target_char>().size();
+		}
+		return length;
+	}
+
 	template <typename cvt_src, typename cvt_des>
 	inline bool default_encode_error_handler(cvt_des& des, enc_res<cvt_src, cvt_des>, ::std::size_t)
 	{
@@ -54,10 +108,32 @@ namespace pdn::unicode
 	{
 		using decision = convert_decision<source_string_view, target_string>;
 
+		constexpr bool bulk = detail::bulk_convertible<source_string_view, target_string>;
+
 		target_string convert_result{};
 
+		if constexpr (bulk)
+		{
+			const auto first = ::std::to_address(::std::cbegin(source));
+			convert_result.reserve(detail::converted_length<decision>(first, first + (::std::cend(source) - ::std::cbegin(source))));
+		}
+
 		for (auto begin = ::std::cbegin(source); begin != ::std::cend(source); )
 		{
+			if constexpr (bulk)
+			{
+				// ASCII run is converted without decoding and encoding
+				const auto run_begin = ::std::to_address(begin);
+				const auto run_count = simd::ascii_prefix_length(run_begin, run_begin + (::std::cend(source) - begin));
+				if (run_count != 0)
+				{
+					const auto old_size = convert_result.size();
+					convert_result.resize(old_size + run_count);
+					simd::convert_ascii(run_begin, run_count, convert_result.data() + old_size);
+					begin += run_count;
+					continue;
+				}
+			}
 			auto curr = begin;
 			auto decode_result = decision::template decode<true>(begin, ::std::cend(source));
 			if (!decode_result)
@@ -0,0 +1,167 @@
+// checks that lexer driven by dfa_transition_table makes same tokens and errors as lexer driven by
+// transformers of dfa_state_objects (dfa_transformer_engine), over lexical error tests and samples of guide.
+// also checks that skip_token stops at same tokens as get_token, with same codes and positions.
+// compile and run in this directory:
+//     g++ -std=c++23 -I../pdn -o lexer_engine_test lexer_engine_test.cpp
+//     ./lexer_engine_test
+// exit code is 0 if all files match.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "spdn.h"
+
+namespace
+{
+    struct recorded_error
+    {
+        pdn::error_code_variant error_code;
+        pdn::source_position    position;
+        pdn::error_msg_string   error_message;
+        friend bool operator==(const recorded_error&, const recorded_error&) = default;
+    };
+
+    // records errors instead of printing them
+    class recording_function_package : public pdn::default_function_package<char8_t>
+    {
+    public:
+        void handle_error(const pdn::error_message& msg)
+        {
+            errors.push_back({ msg.error_code, msg.position, msg.error_message });
+        }
+        std::vector<recorded_error> errors{};
+    };
+
+    bool same_value(const pdn::token_value_variant<char8_t>& lhs, const pdn::token_value_variant<char8_t>& rhs)
+    {
+        if (lhs.index() != rhs.index())
+        {
+            return false;
+        }
+        return std::visit([&]<typename t>(const t& l)
+        {
+            const auto& r = std::get<t>(rhs);
+            if constexpr (std::same_as<t, pdn::proxy<pdn::type::string<char8_t>>>)
+            {
+                return *l == *r;
+            }
+            else if constexpr (std::same_as<t, pdn::detail::at_iden_string_proxy>)
+            {
+                return l.get_id() == r.get_id();
+            }
+            else if constexpr (std::is_floating_point_v<t>)
+            {
+                return std::memcmp(&l, &r, sizeof(t)) == 0; // NaN is same as NaN
+            }
+            else
+            {
+                return l == r;
+            }
+        }, lhs);
+    }
+
+    struct lexed
+    {
+        std::vector<pdn::token<char8_t>> tokens{};
+        std::vector<recorded_error>      errors{};
+    };
+
+    template <typename dfa_engine_t>
+    lexed lex_all(std::u8string_view source)
+    {
+        recording_function_package fp{};
+        pdn::lexer<char8_t, recording_function_package, dfa_engine_t> lex{ fp };
+        auto begin = pdn::make_code_point_iterator(source.begin(), source.end(), fp);
+        lexed result{};
+        for (;;)
+        {
+            result.tokens.push_back(lex.get_token(begin, source.end()));
+            if (result.tokens.back().code == pdn::pdn_token_code::eof)
+            {
+                break;
+            }
+        }
+        result.errors = std::move(fp.errors);
+        return result;
+    }
+
+    std::vector<pdn::token<char8_t>> skip_all(std::u8string_view source)
+    {
+        recording_function_package fp{};
+        pdn::lexer<char8_t, recording_function_package> lex{ fp };
+        auto begin = pdn::make_code_point_iterator(source.begin(), source.end(), fp);
+        std::vector<pdn::token<char8_t>> tokens{};
+        for (;;)
+        {
+            tokens.push_back(lex.skip_token(begin, source.end()));
+            if (tokens.back().code == pdn::pdn_token_code::eof)
+            {
+                break;
+            }
+        }
+        return tokens;
+    }
+
+    bool check_file(const std::filesystem::path& filename)
+    {
+        std::ifstream file{ filename, std::ios::binary };
+        std::string bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        auto source = std::u8string_view{ reinterpret_cast<const char8_t*>(bytes.data()), bytes.size() };
+        if (source.starts_with(u8"\uFEFF"))
+        {
+            source.remove_prefix(3);
+        }
+
+        auto by_table       = lex_all<pdn::dfa_transition_table>(source);
+        auto by_transformer = lex_all<pdn::dfa_transformer_engine>(source);
+
+        bool same = by_table.tokens.size() == by_transformer.tokens.size() && by_table.errors == by_transformer.errors;
+        for (std::size_t i = 0; same && i < by_table.tokens.size(); ++i)
+        {
+            const auto& l = by_table.tokens[i];
+            const auto& r = by_transformer.tokens[i];
+            if (l.code != r.code || l.position != r.position || !same_value(l.value, r.value))
+            {
+                std::cout << "    token " << i << " differs at " << l.position.line << ":" << l.position.column << "\n";
+                same = false;
+            }
+        }
+
+        auto skipped = skip_all(source);
+        same = same && skipped.size() == by_table.tokens.size();
+        for (std::size_t i = 0; same && i < skipped.size(); ++i)
+        {
+            if (skipped[i].code != by_table.tokens[i].code || skipped[i].position != by_table.tokens[i].position)
+            {
+                std::cout << "    skipped token " << i << " differs at " << skipped[i].position.line << ":" << skipped[i].position.column << "\n";
+                same = false;
+            }
+        }
+        std::cout << (same ? "same      " : "DIFFERENT ") << filename.generic_string()
+                  << " (" << by_table.tokens.size() << " tokens, " << by_table.errors.size() << " errors)\n";
+        return same;
+    }
+}
+
+int main()
+{
+    int failed = 0;
+    for (const auto* directory : { "error_test/lexical_error", "../docs/guide-source", "." })
+    {
+        for (const auto& entry : std::filesystem::directory_iterator{ directory })
+        {
+            if (entry.path().extension() == ".spdn" && !check_file(entry.path()))
+            {
+                ++failed;
+            }
+        }
+    }
+    std::cout << (failed == 0 ? "all files match\n" : "some files differ\n");
+    return failed == 0 ? 0 : 1;
+}